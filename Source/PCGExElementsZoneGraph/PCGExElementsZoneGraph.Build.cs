@@ -71,7 +71,8 @@ public class PCGExElementsZoneGraph : ModuleRules
 				new string[]
 				{
 					"UnrealEd",
-					"Settings"
+					"Settings",
+					"DeveloperToolSettings"
 				});
 		}
 	}
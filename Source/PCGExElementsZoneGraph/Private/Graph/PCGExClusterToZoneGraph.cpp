@@ -2,10 +2,18 @@
 // Released under the MIT license https://opensource.org/license/MIT/
 
 #include "Graph/PCGExClusterToZoneGraph.h"
+#include "Graph/PCGExClusterToZoneGraphKernels.h"
 
 #include "PCGComponent.h"
+#include "PCGNode.h"
 #include "PCGExSubSystem.h"
+#include "EngineUtils.h"
+#include "ZoneGraphData.h"
+#include "ZoneGraphSubsystem.h"
 #include "ZoneShapeComponent.h"
+#include "HAL/IConsoleManager.h"
+#include "Hash/xxhash.h"
+#include <type_traits>
 #include "Clusters/PCGExCluster.h"
 #include "Clusters/Artifacts/PCGExChain.h"
 #include "Clusters/Artifacts/PCGExCachedChain.h"
@@ -15,6 +23,8 @@
 #include "Data/PCGExPointIO.h"
 #include "Data/Utils/PCGExDataPreloader.h"
 #include "Details/PCGExSettingsDetails.h"
+#include "Graph/PCGExZoneGraphStorage.h"
+#include "Graph/PCGExZoneShapeBake.h"
 #include "Helpers/PCGExStreamingHelpers.h"
 #include "Helpers/PCGExArrayHelpers.h"
 #include "Helpers/PCGExPointArrayDataHelpers.h"
@@ -27,6 +37,69 @@ namespace PCGExClusterToZoneGraph
 {
 	const FName OutputPolygonPathsLabel = TEXT("Polygon Paths");
 	const FName OutputRoadPathsLabel = TEXT("Road Paths");
+	const FName SourceDirtyBoundsLabel = TEXT("Dirty Bounds");
+
+	static TAutoConsoleVariable<int32> CVarPrecomputeCacheMaxMB(
+		TEXT("pcgex.ZoneGraph.PrecomputeCacheMaxMB"), 256,
+		TEXT("Memory cap of the Cluster to Zone Graph precompute cache, in megabytes. Least recently used clusters are evicted past it."));
+
+	static TAutoConsoleVariable<int32> CVarChainCacheMaxMB(
+		TEXT("pcgex.ZoneGraph.ChainCacheMaxMB"), 64,
+		TEXT("Memory cap of the Cluster to Zone Graph chain cache, in megabytes. Least recently used clusters are evicted past it."));
+
+	static FAutoConsoleCommand CmdFlushPrecomputeCache(
+		TEXT("pcgex.ZoneGraph.FlushPrecomputeCache"),
+		TEXT("Releases every cluster held by the Cluster to Zone Graph precompute and chain caches."),
+		FConsoleCommandDelegate::CreateLambda(
+			[]()
+			{
+				FPrecomputeCache::Get().Empty();
+				FChainCache::Get().Empty();
+			}));
+
+	SIZE_T GetCacheMaxSize(const TAutoConsoleVariable<int32>& InCVar)
+	{
+		return static_cast<SIZE_T>(FMath::Max(0, InCVar.GetValueOnAnyThread())) * 1024 * 1024;
+	}
+
+	/** Hashes every settings property, along with the interned lane profiles processors index into. */
+	uint64 HashPrecomputeSettings(const UPCGExClusterToZoneGraphSettings* InSettings, const TArray<FLaneProfileEntry>& InLaneProfiles)
+	{
+		FXxHash64Builder Builder;
+
+		FString Text;
+		for (TFieldIterator<FProperty> It(InSettings->GetClass()); It; ++It)
+		{
+			Text.Reset();
+			It->ExportTextItem_InContainer(Text, InSettings, nullptr, nullptr, PPF_None);
+			Builder.Update(*Text, Text.Len() * sizeof(TCHAR));
+		}
+
+		for (const FLaneProfileEntry& Entry : InLaneProfiles)
+		{
+			Builder.Update(&Entry.Profile.ID, sizeof(FGuid));
+			Builder.Update(&Entry.TotalWidth, sizeof(double));
+			Builder.Update(&Entry.MaxLaneWidth, sizeof(double));
+		}
+
+		return Builder.Finalize().Hash;
+	}
+
+	FLaneProfileEntry::FLaneProfileEntry(const FZoneLaneProfileRef& InProfile)
+		: Profile(InProfile)
+	{
+		if (const UZoneGraphSettings* ZGSettings = GetDefault<UZoneGraphSettings>())
+		{
+			if (const FZoneLaneProfile* LaneProfile = ZGSettings->GetLaneProfileByRef(Profile))
+			{
+				TotalWidth = LaneProfile->GetLanesTotalWidth();
+				for (const FZoneLaneDesc& Lane : LaneProfile->Lanes)
+				{
+					MaxLaneWidth = FMath::Max(MaxLaneWidth, static_cast<double>(Lane.Width));
+				}
+			}
+		}
+	}
 }
 
 PCGExData::EIOInit UPCGExClusterToZoneGraphSettings::GetEdgeOutputInitMode() const { return PCGExData::EIOInit::Forward; }
@@ -40,6 +113,13 @@ void UPCGExClusterToZoneGraphSettings::PostEditChangeProperty(struct FPropertyCh
 }
 #endif
 
+TArray<FPCGPinProperties> UPCGExClusterToZoneGraphSettings::InputPinProperties() const
+{
+	TArray<FPCGPinProperties> PinProperties = Super::InputPinProperties();
+	PCGEX_PIN_POINTS(PCGExClusterToZoneGraph::SourceDirtyBoundsLabel, "Optional dirty regions, one box per point. When connected and components are reused, only shapes touching these regions are rebuilt.", Advanced)
+	return PinProperties;
+}
+
 TArray<FPCGPinProperties> UPCGExClusterToZoneGraphSettings::OutputPinProperties() const
 {
 	TArray<FPCGPinProperties> PinProperties = Super::OutputPinProperties();
@@ -57,6 +137,300 @@ PCGEX_INITIALIZE_ELEMENT(ClusterToZoneGraph)
 
 PCGEX_ELEMENT_BATCH_EDGE_IMPL_ADV(ClusterToZoneGraph)
 
+FName FPCGExClusterToZoneGraphContext::MakeComponentName(UObject* InOuter)
+{
+	// Counter-based names only probe for the rare collision with objects already living in the outer,
+	// instead of going through MakeUniqueObjectName for every component.
+	static const FName BaseName = FName(TEXT("PCGZoneGraphComponent"));
+
+	FName Name;
+	do { Name = FName(BaseName, ++ComponentNameCounter); }
+	while (StaticFindObjectFast(nullptr, InOuter, Name));
+
+	return Name;
+}
+
+void FPCGExClusterToZoneGraphContext::CollectReusableShapes(const AActor* InTargetActor)
+{
+	// Shapes kept by the previous execution's soft cleanup are still flagged unused at this point
+	UPCGComponent* PCGComponent = const_cast<UPCGComponent*>(GetComponent());
+	if (!PCGComponent) { return; }
+
+	// Identities shared by several components are ambiguous, none of them is reused and their shapes are rebuilt
+	TSet<uint64> Ambiguous;
+	PCGComponent->ForEachManagedResource(
+		[&](UPCGManagedResource* Resource)
+		{
+			UPCGExManagedZoneShapeComponent* ManagedShape = Cast<UPCGExManagedZoneShapeComponent>(Resource);
+			if (!ManagedShape || !ManagedShape->IsMarkedUnused() || ManagedShape->ShapeId == 0) { return; }
+
+			// Only live zone shapes on the target actor can be claimed later, anything else is rebuilt
+			const UActorComponent* Component = ManagedShape->GetComponent();
+			if (!IsValid(Component) || !Component->IsA<UZoneShapeComponent>() || Component->GetOwner() != InTargetActor) { return; }
+
+			if (ReusableShapes.Contains(ManagedShape->ShapeId)) { Ambiguous.Add(ManagedShape->ShapeId); }
+			else { ReusableShapes.Add(ManagedShape->ShapeId, ManagedShape); }
+		});
+
+	for (const uint64 ShapeId : Ambiguous) { ReusableShapes.Remove(ShapeId); }
+}
+
+bool FPCGExClusterToZoneGraphContext::HasReusableShape(const uint64 ShapeId) const
+{
+	return ReusableShapes.Contains(ShapeId);
+}
+
+UPCGExManagedZoneShapeComponent* FPCGExClusterToZoneGraphContext::ClaimReusableShape(const uint64 ShapeId, const AActor* InTargetActor)
+{
+	// The map itself stays untouched past boot so processors can read it concurrently, claims are tracked by the unused flag
+	UPCGExManagedZoneShapeComponent* const* Found = ReusableShapes.Find(ShapeId);
+	if (!Found || !(*Found)->IsMarkedUnused()) { return nullptr; }
+
+	UPCGExManagedZoneShapeComponent* ManagedShape = *Found;
+	const UActorComponent* Component = ManagedShape->GetComponent();
+	if (!Component || Component->GetOwner() != InTargetActor || !Component->IsA<UZoneShapeComponent>()) { return nullptr; }
+
+	ManagedShape->MarkAsReused();
+	return ManagedShape;
+}
+
+void FPCGExClusterToZoneGraphContext::AttachShapeComponent(AActor* InTargetActor, UZoneShapeComponent* InComponent, UPCGExManagedZoneShapeComponent* InManagedShape, const FAttachmentTransformRules& InRules)
+{
+	if (!InManagedShape)
+	{
+		AttachManagedComponent(InTargetActor, InComponent, InRules);
+		return;
+	}
+
+	// Reusable shapes register their own managed resource, which PCG keeps across soft cleanups
+	UPCGComponent* PCGComponent = const_cast<UPCGComponent*>(GetComponent());
+
+	InTargetActor->Modify(!PCGComponent->IsInPreviewMode());
+	InComponent->RegisterComponent();
+	InTargetActor->AddInstanceComponent(InComponent);
+	InComponent->AttachToComponent(InTargetActor->GetRootComponent(), InRules);
+
+	PCGComponent->AddToManagedResources(InManagedShape);
+}
+
+#if WITH_EDITOR
+void FPCGExClusterToZoneGraphContext::AddExtraStructReferencedObjects(FReferenceCollector& Collector)
+{
+	FPCGExClustersProcessorContext::AddExtraStructReferencedObjects(Collector);
+
+	// Held reusable shapes aren't referenced by anything else until they are attached
+	for (PCGExClusterToZoneGraph::FHeldShape& Held : HeldShapes)
+	{
+		Collector.AddReferencedObject(Held.TargetActor);
+		Collector.AddReferencedObject(Held.Component);
+		Collector.AddReferencedObject(Held.ManagedShape);
+	}
+}
+#endif
+
+void FPCGExClusterToZoneGraphContext::HoldShape(AActor* InTargetActor, UZoneShapeComponent* InComponent, UPCGExManagedZoneShapeComponent* InManagedShape, const FAttachmentTransformRules& InRules, const bool bAttach)
+{
+#if WITH_EDITOR
+	if (LastHoldFrame != GFrameCounter)
+	{
+		LastHoldFrame = GFrameCounter;
+		NumHoldTicks++;
+	}
+
+	PCGExClusterToZoneGraph::FHeldShape& Held = HeldShapes.Emplace_GetRef();
+	Held.TargetActor = InTargetActor;
+	Held.Component = InComponent;
+	Held.ManagedShape = InManagedShape;
+	Held.AttachmentRules = InRules;
+	Held.bAttach = bAttach;
+#endif
+}
+
+bool FPCGExClusterToZoneGraphContext::HasHeldShapes() const
+{
+#if WITH_EDITOR
+	return !HeldShapes.IsEmpty();
+#else
+	return false;
+#endif
+}
+
+bool FPCGExClusterToZoneGraphContext::ReleaseHeldShapes(const UPCGExClusterToZoneGraphSettings* Settings)
+{
+#if WITH_EDITOR
+	if (HeldShapes.IsEmpty()) { return true; }
+
+	// Updates and attachments share the compile budget, spread over as many ticks as they need
+	const int32 ReleaseStart = NumReleasedShapes;
+	const bool bReleased = CompileScheduler->RunBudgeted(
+		[&]()
+		{
+			const PCGExClusterToZoneGraph::FHeldShape& Held = HeldShapes[NumReleasedShapes++];
+			if (IsValid(Held.Component) && IsValid(Held.TargetActor))
+			{
+				Held.Component->UpdateShape();
+				if (Held.bAttach) { AttachShapeComponent(Held.TargetActor, Held.Component, Held.ManagedShape, Held.AttachmentRules); }
+			}
+
+			return NumReleasedShapes < HeldShapes.Num();
+		});
+
+	if (NumReleasedShapes > ReleaseStart && LastReleaseFrame != GFrameCounter)
+	{
+		LastReleaseFrame = GFrameCounter;
+		NumReleaseTicks++;
+	}
+
+	if (!bReleased) { return false; }
+
+	UWorld* World = nullptr;
+	TSet<ULevel*> Levels;
+
+	for (const PCGExClusterToZoneGraph::FHeldShape& Held : HeldShapes)
+	{
+		if (!IsValid(Held.Component) || !IsValid(Held.TargetActor)) { continue; }
+
+		World = Held.TargetActor->GetWorld();
+		Levels.Add(Held.TargetActor->GetLevel());
+	}
+
+	HeldShapes.Empty();
+	NumReleasedShapes = 0;
+
+	// Every shape change is in, rebuild the data of the affected levels once rather than on each tick that emitted shapes
+	if (UZoneGraphSubsystem* ZoneGraphSubsystem = World ? UWorld::GetSubsystem<UZoneGraphSubsystem>(World) : nullptr)
+	{
+		TArray<AZoneGraphData*> Affected;
+		for (TActorIterator<AZoneGraphData> It(World); It; ++It)
+		{
+			if (Levels.Contains(It->GetLevel())) { Affected.Add(*It); }
+		}
+
+		// Levels without a data actor yet go through the subsystem, which spawns the missing ones
+		if (Affected.Num() == Levels.Num()) { ZoneGraphSubsystem->GetBuilder().BuildAll(Affected, false); }
+		else { ZoneGraphSubsystem->RebuildGraph(false); }
+	}
+
+	if (Settings->bLogCompileStats)
+	{
+		// Each tick that emits or releases shapes would have triggered a rebuild of its own
+		PCGE_LOG_C(
+			Log, LogOnly, this,
+			FText::Format(
+				FTEXT("Shapes emitted over {0} ticks were released over {1}, avoiding {2} ZoneGraph rebuilds."),
+				FText::AsNumber(NumHoldTicks),
+				FText::AsNumber(NumReleaseTicks),
+				FText::AsNumber(FMath::Max(0, NumHoldTicks - NumReleaseTicks))));
+	}
+#endif
+
+	return true;
+}
+
+void FPCGExClusterToZoneGraphContext::TrackStagingBytes(const int64 Delta)
+{
+	const int64 Current = StagingBytes.fetch_add(Delta) + Delta;
+	int64 Peak = PeakStagingBytes.load();
+	while (Current > Peak && !PeakStagingBytes.compare_exchange_weak(Peak, Current))
+	{
+	}
+}
+
+bool FPCGExClusterToZoneGraphContext::WriteBakedShapes(const UPCGExClusterToZoneGraphSettings* Settings)
+{
+	AActor* TargetActor = GetTargetActor(nullptr);
+	if (!TargetActor)
+	{
+		PCGE_LOG_C(Error, GraphAndLog, this, FTEXT("Invalid target actor."));
+		return false;
+	}
+
+	FString BakedFile = Settings->BakedShapesFile;
+	if (Settings->bBakeShapes)
+	{
+		// Several PCG components or nodes may bake onto the same actor, each gets its own default file
+		if (BakedFile.IsEmpty())
+		{
+			const FString NodeName = Node ? Node->GetFName().ToString() : FString();
+			BakedFile = PCGExZoneShapeBake::MakeDefaultPath(TargetActor, FString::Printf(TEXT("%s_%s"), *GetComponent()->GetName(), *NodeName));
+		}
+
+		if (!BakeWriter->Save(BakedFile))
+		{
+			PCGE_LOG_C(Error, GraphAndLog, this, FText::Format(FTEXT("Could not write baked zone shapes to '{0}'."), FText::FromString(BakedFile)));
+			return false;
+		}
+
+#if WITH_EDITOR
+		if (!PCGExZoneShapeBake::StageWithContent(BakedFile))
+		{
+			PCGE_LOG_C(Warning, GraphAndLog, this, FText::Format(FTEXT("'{0}' is outside the Content directory and won't be staged with cooked builds."), FText::FromString(BakedFile)));
+		}
+#endif
+	}
+
+	const EObjectFlags Flags = GetComponent()->IsInPreviewMode() ? RF_Transient : RF_NoFlags;
+	UPCGExZoneLanesComponent* Holder = nullptr;
+
+	if (Settings->bBakeShapes)
+	{
+		UPCGExBakedZoneShapesComponent* Baked = ManagedObjects->New<UPCGExBakedZoneShapesComponent>(TargetActor, MakeComponentName(TargetActor), Flags);
+		if (Baked) { Baked->BakedFile = BakedFile; }
+		Holder = Baked;
+	}
+	else
+	{
+		UPCGExZoneShapeContainerComponent* Container = ManagedObjects->New<UPCGExZoneShapeContainerComponent>(TargetActor, MakeComponentName(TargetActor), Flags);
+		if (Container) { BakeWriter->Write(Container->PackedShapes); }
+		Holder = Container;
+	}
+
+	if (!Holder) { return false; }
+
+	Holder->ComponentTags.Append(ComponentTags);
+	AttachManagedComponent(TargetActor, Holder, Settings->AttachmentRules.GetRules());
+
+	// Lanes are emitted here rather than on registration, a no-op when the component already began play
+	Holder->EmitLanes();
+	AddNotifyActor(TargetActor);
+
+	return true;
+}
+
+bool FPCGExClusterToZoneGraphContext::WriteZoneGraphStorage()
+{
+	AActor* TargetActor = GetTargetActor(nullptr);
+	if (!TargetActor)
+	{
+		PCGE_LOG_C(Error, GraphAndLog, this, FTEXT("Invalid target actor."));
+		return false;
+	}
+
+#if WITH_EDITOR
+	// The editor builder rebuilds every ZoneGraph Data of a level from its shape components, emitted lanes don't survive it
+	if (!TargetActor->GetWorld()->IsGameWorld() && GetDefault<UZoneGraphSettings>()->ShouldBuildZoneGraphWhileEditing())
+	{
+		PCGE_LOG_C(Warning, GraphAndLog, this, FTEXT("ZoneGraph builds while editing are enabled, the next editor build will replace the emitted lanes with lanes from the level's shape components."));
+	}
+#endif
+
+	UPCGComponent* PCGComponent = const_cast<UPCGComponent*>(GetComponent());
+	AZoneGraphData* ZoneGraphData = StorageWriter->Emit(TargetActor, PCGComponent->IsInPreviewMode() ? RF_Transient : RF_NoFlags);
+	if (!ZoneGraphData)
+	{
+		PCGE_LOG_C(Error, GraphAndLog, this, FTEXT("Could not spawn a ZoneGraph Data actor."));
+		return false;
+	}
+
+	// The data actor is cleaned up along with the rest of the generated output
+	UPCGManagedActors* ManagedActors = NewObject<UPCGManagedActors>(PCGComponent);
+	ManagedActors->GetMutableGeneratedActors().Add(ZoneGraphData);
+	PCGComponent->AddToManagedResources(ManagedActors);
+	AddNotifyActor(TargetActor);
+
+	return true;
+}
+
 bool FPCGExClusterToZoneGraphElement::Boot(FPCGExContext* InContext) const
 {
 	PCGEX_CONTEXT_AND_SETTINGS(ClusterToZoneGraph)
@@ -74,16 +448,101 @@ bool FPCGExClusterToZoneGraphElement::Boot(FPCGExContext* InContext) const
 		*/
 	}
 
+	Context->LaneProfiles.Emplace(Settings->LaneProfile);
+
 	if (Settings->bOverrideLaneProfile)
 	{
 		if (const UZoneGraphSettings* ZGSettings = GetDefault<UZoneGraphSettings>())
 		{
-			for (const FZoneLaneProfile& Profile : ZGSettings->GetLaneProfiles())
+			const TArray<FZoneLaneProfile>& Profiles = ZGSettings->GetLaneProfiles();
+			Context->LaneProfiles.Reserve(Profiles.Num() + 1);
+			Context->LaneProfileMap.Reserve(Profiles.Num());
+
+			for (const FZoneLaneProfile& Profile : Profiles)
+			{
+				Context->LaneProfileMap.Add(Profile.Name, Context->LaneProfiles.Emplace(FZoneLaneProfileRef(Profile)));
+			}
+		}
+	}
+
+	// Tags are resolved once, rather than per spawned component
+	TArray<FString> TagStrings;
+	Settings->CommaSeparatedComponentTags.ParseIntoArray(TagStrings, TEXT(","), true);
+	for (FString& Tag : TagStrings)
+	{
+		Tag.TrimStartAndEndInline();
+		if (!Tag.IsEmpty()) { Context->ComponentTags.AddUnique(FName(Tag)); }
+	}
+
+	if (Settings->bReuseComponents)
+	{
+		Context->CollectReusableShapes(Context->GetTargetActor(nullptr));
+
+		// Dirty regions only make sense when there are previous components to keep
+		for (const FPCGTaggedData& TaggedData : Context->InputData.GetInputsByPin(PCGExClusterToZoneGraph::SourceDirtyBoundsLabel))
+		{
+			if (const UPCGBasePointData* PointData = Cast<UPCGBasePointData>(TaggedData.Data))
+			{
+				const TConstPCGValueRange<FTransform> Transforms = PointData->GetConstTransformValueRange();
+				const TConstPCGValueRange<FVector> BoundsMin = PointData->GetConstBoundsMinValueRange();
+				const TConstPCGValueRange<FVector> BoundsMax = PointData->GetConstBoundsMaxValueRange();
+				for (int32 i = 0; i < Transforms.Num(); i++) { Context->DirtyBounds.Add(FBox(BoundsMin[i], BoundsMax[i]).TransformBy(Transforms[i])); }
+			}
+			else if (const UPCGSpatialData* SpatialData = Cast<UPCGSpatialData>(TaggedData.Data))
 			{
-				Context->LaneProfileMap.Add(Profile.Name, FZoneLaneProfileRef(Profile));
+				Context->DirtyBounds.Add(SpatialData->GetBounds());
 			}
 		}
 	}
+	else if (!Context->InputData.GetInputsByPin(PCGExClusterToZoneGraph::SourceDirtyBoundsLabel).IsEmpty())
+	{
+		PCGE_LOG_C(Warning, GraphAndLog, Context, FTEXT("Dirty bounds are ignored unless components are reused."));
+	}
+
+	if (Settings->bBakeShapes || (Settings->bPackShapes && !Settings->bEmitZoneGraphStorage))
+	{
+		TArray<FZoneLaneProfileRef> Profiles;
+		Profiles.Reserve(Context->LaneProfiles.Num());
+		for (const PCGExClusterToZoneGraph::FLaneProfileEntry& Entry : Context->LaneProfiles) { Profiles.Add(Entry.Profile); }
+		Context->BakeWriter = MakeShared<PCGExZoneShapeBake::FWriter>(Profiles);
+	}
+	else if (Settings->bEmitZoneGraphStorage)
+	{
+		Context->StorageWriter = MakeShared<PCGExZoneGraphStorage::FWriter>();
+
+		const UZoneGraphSettings* ZGSettings = GetDefault<UZoneGraphSettings>();
+		Context->StorageLaneProfiles.Reserve(Context->LaneProfiles.Num());
+		for (const PCGExClusterToZoneGraph::FLaneProfileEntry& Entry : Context->LaneProfiles)
+		{
+			const FZoneLaneProfile* LaneProfile = ZGSettings ? ZGSettings->GetLaneProfileByRef(Entry.Profile) : nullptr;
+			Context->StorageLaneProfiles.Add(LaneProfile ? *LaneProfile : FZoneLaneProfile());
+		}
+
+		// Lanes carry the same tags a freshly created shape component would
+		Context->StorageDefaultTags = GetDefault<UZoneShapeComponent>()->GetTags();
+	}
+
+	if (Settings->bCachePrecompute)
+	{
+		Context->bUsePrecomputeCache = Settings->OrientationMode != EPCGExZGOrientationMode::SortDirection;
+		if (Context->bUsePrecomputeCache) { Context->PrecomputeSettingsHash = PCGExClusterToZoneGraph::HashPrecomputeSettings(Settings, Context->LaneProfiles); }
+
+		// Filter factories are regenerated whenever their own inputs or settings change, so their identity stands for their config
+		Context->bUseChainCache = true;
+		FXxHash64Builder Builder;
+		for (const auto& Factory : Context->FilterFactories) { Builder.Update(&Factory->UID, sizeof(Factory->UID)); }
+		Context->ChainFilterHash = Builder.Finalize().Hash;
+	}
+
+#if WITH_EDITOR
+	// Read-only: the project setting is left as the user set it
+	if (const UWorld* World = Context->GetComponent() ? Context->GetComponent()->GetWorld() : nullptr)
+	{
+		Context->bHoldZoneGraphBuilds = !World->IsGameWorld() && GetDefault<UZoneGraphSettings>()->ShouldBuildZoneGraphWhileEditing();
+	}
+#endif
+
+	Context->CompileScheduler = MakeShared<PCGExClusterToZoneGraph::FCompileScheduler>(Context, Settings->CompileFrameBudgetMs * 0.001, Settings->bLogCompileStats);
 
 	if (Settings->bOutputPolygonPaths)
 	{
@@ -122,6 +581,22 @@ bool FPCGExClusterToZoneGraphElement::AdvanceWork(FPCGExContext* InContext, cons
 
 	PCGEX_CLUSTER_BATCH_PROCESSING(PCGExCommon::States::State_Done)
 
+	// Emitted lanes are merged on the worker thread, only handing them to their actor needs the game thread
+	if (Context->StorageWriter && !Context->StorageWriter->IsBuilt()) { Context->StorageWriter->Build(); }
+
+	// Baking, storage emission and held shapes touch objects and post-process functions call into the target actors, so this last step alone hops to the game thread.
+	if ((Context->BakeWriter || Context->StorageWriter || Context->HasHeldShapes() || !Settings->PostProcessFunctionNames.IsEmpty()) && !IsInGameThread())
+	{
+		Context->bRequiresGameThread = true;
+		return false;
+	}
+
+	// Held shapes are released within the compile budget, this step is re-entered until they are all in
+	if (!Context->ReleaseHeldShapes(Settings)) { return false; }
+
+	if (Context->BakeWriter && !Context->WriteBakedShapes(Settings)) { return Context->CancelExecution(TEXT("Could not write baked zone shapes.")); }
+	if (Context->StorageWriter && !Context->WriteZoneGraphStorage()) { return Context->CancelExecution(TEXT("Could not emit zone graph storage.")); }
+
 	Context->OutputBatches();
 	Context->OutputPointsAndEdges();
 	Context->ExecuteOnNotifyActors(Settings->PostProcessFunctionNames);
@@ -135,383 +610,616 @@ bool FPCGExClusterToZoneGraphElement::AdvanceWork(FPCGExContext* InContext, cons
 	return Context->TryComplete();
 }
 
-namespace PCGExClusterToZoneGraph
+bool FPCGExClusterToZoneGraphElement::CanExecuteOnlyOnMainThread(FPCGContext* Context) const
 {
-	FZGBase::FZGBase(FProcessor* InProcessor)
-		: Processor(InProcessor)
-	{
-	}
+	// Component spawning is marshalled to the game thread by the compile scheduler,
+	// everything else runs on worker threads unless the element explicitly asks for the game thread.
+	if (Context && static_cast<const FPCGExClusterToZoneGraphContext*>(Context)->bRequiresGameThread) { return true; }
+	return FPCGExClustersProcessorElement::CanExecuteOnlyOnMainThread(Context);
+}
 
-	void FZGBase::InitComponent(AActor* InTargetActor)
+namespace PCGExClusterToZoneGraph
+{
+	namespace Kernels
 	{
-		if (!InTargetActor)
+		/** Node accessor of road precompute over a cluster. */
+		struct FClusterNodes
 		{
-			PCGE_LOG_C(Error, GraphAndLog, Processor->GetContext(), FTEXT("Invalid target actor."));
-			return;
-		}
+			PCGExClusters::FCluster* Cluster = nullptr;
 
-		// This executes on the main thread for safety
-		const FString ComponentName = TEXT("PCGZoneGraphComponent");
-		const EObjectFlags ObjectFlags = (Processor->GetContext()->GetComponent()->IsInPreviewMode() ? RF_Transient : RF_NoFlags);
-		Component = Processor->GetContext()->ManagedObjects->New<UZoneShapeComponent>(InTargetActor, MakeUniqueObjectName(InTargetActor, UZoneShapeComponent::StaticClass(), FName(ComponentName)), ObjectFlags);
+			explicit FClusterNodes(PCGExClusters::FCluster* InCluster)
+				: Cluster(InCluster)
+			{
+			}
 
-		Component->ComponentTags.Reserve(Component->ComponentTags.Num() + Processor->GetContext()->ComponentTags.Num());
-		for (const FString& ComponentTag : Processor->GetContext()->ComponentTags) { Component->ComponentTags.Add(FName(ComponentTag)); }
-	}
+			FORCEINLINE FVector GetPos(const int32 Node) const { return Cluster->GetPos(Node); }
+			FORCEINLINE int32 GetPointIndex(const int32 Node) const { return Cluster->GetNode(Node)->PointIndex; }
+			FORCEINLINE bool IsLeaf(const int32 Node) const { return Cluster->GetNode(Node)->IsLeaf(); }
+		};
 
-	FZGRoad::FZGRoad(FProcessor* InProcessor, const TSharedPtr<PCGExClusters::FNodeChain>& InChain, const bool InReverse)
-		: FZGBase(InProcessor), Chain(InChain), bIsReversed(InReverse)
-	{
-	}
+		FRotator MakeShapeRotation(const FVector& Forward)
+		{
+			FZoneShapePoint Point;
+			Point.SetRotationFromForwardAndUp(Forward, FVector::UpVector);
+			return Point.Rotation;
+		}
 
-	void FZGRoad::ResolveLaneProfile(const TSharedPtr<PCGExClusters::FCluster>& Cluster)
-	{
-		const auto* S = Processor->GetSettings();
+		uint32 MortonCode(const FVector& Cell)
+		{
+			auto Spread = [](const double Value)
+			{
+				uint32 V = static_cast<uint32>(FMath::Clamp(Value, 0.0, 1023.0));
+				V = (V | (V << 16)) & 0x030000FF;
+				V = (V | (V << 8)) & 0x0300F00F;
+				V = (V | (V << 4)) & 0x030C30C3;
+				V = (V | (V << 2)) & 0x09249249;
+				return V;
+			};
+
+			return Spread(Cell.X) | (Spread(Cell.Y) << 1) | (Spread(Cell.Z) << 2);
+		}
 
-		if (Processor->EdgeLaneProfileBuffer)
+		void ComputeChordForwards(const FVector* Positions, FVector* Forwards, const int32 Num, const bool bLoop, FPrecomputeScratch& Scratch)
 		{
-			// Majority vote across chain edges
-			TMap<FName, int32> ProfileCounts;
-			for (const PCGExClusters::FLink& Link : Chain->Links)
+			TSplitVectors<double>& Points = Scratch.Lanes.Points;
+			TSplitVectors<double>& Directions = Scratch.Lanes.Directions;
+			Points.Split(Positions, Num, FVector::ZeroVector);
+			Directions.SetNum(Num);
+
+			const TLanes<double> Zero = {VectorZeroDouble(), VectorZeroDouble(), VectorZeroDouble()};
+			VectorRegister4Double Length;
+
+			// Segment directions, with the wrap-around segment in the last slot
+			for (int32 i = 0; i < Num - 1; i += NumLanes)
 			{
-				if (Link.Edge < 0) { continue; }
-				const PCGExClusters::FEdge* Edge = Cluster->GetEdge(Link);
-				ProfileCounts.FindOrAdd(Processor->EdgeLaneProfileBuffer->Read(Edge->PointIndex))++;
+				SafeNormal<double>(TLanes<double>::Load(Points, i + 1) - TLanes<double>::Load(Points, i), Zero, Length).Store(Directions, i);
 			}
 
-			FName MostCommon = NAME_None;
-			int32 MaxCount = 0;
-			for (const auto& [Name, Count] : ProfileCounts)
+			const FVector Wrap = (Positions[0] - Positions[Num - 1]).GetSafeNormal();
+			Directions.X[Num - 1] = Wrap.X;
+			Directions.Y[Num - 1] = Wrap.Y;
+			Directions.Z[Num - 1] = Wrap.Z;
+
+			// Interior points, opposite directions cancel out and fall back to the outgoing one.
+			// Blends are written over the points, which aren't read past the segment pass.
+			for (int32 i = 1; i < Num - 1; i += NumLanes)
 			{
-				if (Count > MaxCount)
-				{
-					MaxCount = Count;
-					MostCommon = Name;
-				}
+				const TLanes<double> Next = TLanes<double>::Load(Directions, i);
+				SafeNormal<double>(TLanes<double>::Load(Directions, i - 1) + Next, Next, Length).Store(Points, i);
 			}
 
-			CachedLaneProfile = Processor->ResolveLaneProfileByName(MostCommon);
-		}
-		else
-		{
-			CachedLaneProfile = S->LaneProfile;
+			for (int32 i = 1; i < Num - 1; i++) { Forwards[i] = Points.Get(i); }
+
+			auto Blend = [&](const int32 Prev, const int32 Next)
+			{
+				const FVector DirNext = Directions.Get(Next);
+				const FVector Sum = Directions.Get(Prev) + DirNext;
+				const double SizeSquared = Sum.SizeSquared();
+				return SizeSquared > UE_SMALL_NUMBER ? Sum / FMath::Sqrt(SizeSquared) : DirNext;
+			};
+
+			// Endpoints
+			if (bLoop)
+			{
+				Forwards[0] = Blend(Num - 1, 0);
+				Forwards[Num - 1] = Blend(Num - 2, Num - 1);
+			}
+			else
+			{
+				Forwards[0] = Directions.Get(0);
+				Forwards[Num - 1] = Directions.Get(Num - 2);
+			}
 		}
 
-		// Cache lane widths from resolved profile
-		if (const UZoneGraphSettings* ZGSettings = GetDefault<UZoneGraphSettings>())
+		void BuildRotations(const FVector* Forwards, FRotator* Rotations, const int32 Num)
 		{
-			if (const FZoneLaneProfile* Profile = ZGSettings->GetLaneProfileByRef(CachedLaneProfile))
+			const VectorRegister4Double RadToDeg = VectorSetFloat1(180.0 / UE_DOUBLE_PI);
+			const VectorRegister4Double VerticalTolerance = VectorSetFloat1(1e-3); // Past the shape point's own up axis switch
+
+			for (int32 i = 0; i < Num; i += NumLanes)
 			{
-				CachedTotalProfileWidth = Profile->GetLanesTotalWidth();
-				for (const FZoneLaneDesc& Lane : Profile->Lanes)
+				const int32 NumValid = FMath::Min(NumLanes, Num - i);
+
+				// Transposed on the stack, tail lanes are zero and never written back
+				double X[NumLanes] = {0, 0, 0, 0};
+				double Y[NumLanes] = {0, 0, 0, 0};
+				double Z[NumLanes] = {0, 0, 0, 0};
+				for (int32 l = 0; l < NumValid; l++)
+				{
+					X[l] = Forwards[i + l].X;
+					Y[l] = Forwards[i + l].Y;
+					Z[l] = Forwards[i + l].Z;
+				}
+
+				const VectorRegister4Double FX = VectorLoad(X);
+				const VectorRegister4Double FY = VectorLoad(Y);
+				const VectorRegister4Double FZ = VectorLoad(Z);
+
+				// Forward and world up give a roll-free rotation: pitch from the horizontal length, yaw from the heading.
+				// VectorATan2 takes its numerator first.
+				const VectorRegister4Double HorizontalSquared = VectorMultiplyAdd(FX, FX, VectorMultiply(FY, FY));
+				const VectorRegister4Double SizeSquared = VectorMultiplyAdd(FZ, FZ, HorizontalSquared);
+
+				double Pitch[NumLanes];
+				double Yaw[NumLanes];
+				VectorStore(VectorMultiply(VectorATan2(FZ, VectorSqrt(HorizontalSquared)), RadToDeg), Pitch);
+				VectorStore(VectorMultiply(VectorATan2(FY, FX), RadToDeg), Yaw);
+
+				const int32 Fallback = VectorMaskBits(VectorCompareGE(VectorMultiply(SizeSquared, VerticalTolerance), HorizontalSquared));
+
+				for (int32 l = 0; l < NumValid; l++)
 				{
-					CachedMaxLaneWidth = FMath::Max(CachedMaxLaneWidth, static_cast<double>(Lane.Width));
+					Rotations[i + l] = (Fallback & (1 << l)) ? MakeShapeRotation(Forwards[i + l]) : FRotator(Pitch[l], Yaw[l], 0);
 				}
 			}
 		}
 	}
 
-	void FZGRoad::Precompute(const TSharedPtr<PCGExClusters::FCluster>& Cluster)
+	void FShapePointBuffer::SetNum(const int32 InNum)
 	{
-		const auto* S = Processor->GetSettings();
-		const FZoneShapePointType DefaultPointType = S->RoadPointType;
+		Positions.SetNumUninitialized(InNum);
+		Forwards.SetNumUninitialized(InNum);
+		Rotations.SetNumUninitialized(InNum);
+		TangentLengths.SetNumUninitialized(InNum);
+		Types.SetNumUninitialized(InNum);
+	}
 
-		TArray<int32> Nodes;
-		const int32 ChainSize = Chain->GetNodes(Cluster, Nodes, bIsReversed);
+	void FShapePointBuffer::Empty()
+	{
+		Positions.Empty();
+		Forwards.Empty();
+		Rotations.Empty();
+		TangentLengths.Empty();
+		Types.Empty();
+	}
 
-		// Single-edge chains: GetNodes uses edge Start/End topology which may not match
-		// the chain's Seed/Last ordering. Fix ordering for correct endpoint processing.
-		if (ChainSize == 2 && !Chain->bIsClosedLoop)
-		{
-			const int32 ExpectedFirst = bIsReversed ? Chain->Links.Last().Node : Chain->Seed.Node;
-			if (Nodes[0] != ExpectedFirst) { Swap(Nodes[0], Nodes[1]); }
-		}
+	SIZE_T FShapePointBuffer::GetAllocatedSize() const
+	{
+		return Positions.GetAllocatedSize() + Forwards.GetAllocatedSize() + Rotations.GetAllocatedSize() + TangentLengths.GetAllocatedSize() + Types.GetAllocatedSize();
+	}
 
-		PCGExArrayHelpers::InitArray(PrecomputedPoints, ChainSize);
+	void FCompileBudget::Record(const bool bPolygon, const double Seconds)
+	{
+		// Exponential moving average, seeded with the first sample
+		double& Cost = bPolygon ? PolygonCost : RoadCost;
+		Cost = Cost > 0 ? FMath::Lerp(Cost, Seconds, 0.25) : Seconds;
+	}
 
-		if (Chain->bIsClosedLoop)
-		{
-			const int32 FirstNode = Nodes[0];
-			Nodes.Add(FirstNode);
-		}
+	void FCompileBudget::RecordTick(const double Seconds)
+	{
+		NumTicks++;
+		TotalSeconds += Seconds;
+		WorstTickSeconds = FMath::Max(WorstTickSeconds, Seconds);
+	}
 
-		for (int i = 0; i < ChainSize; i++)
-		{
-			const FVector Position = Cluster->GetPos(Nodes[i]);
-			const int32 NodePointIndex = Cluster->GetNode(Nodes[i])->PointIndex;
+	namespace
+	{
+		// Game-thread time spent compiling during the current frame, shared by every scheduler
+		// so several nodes compiling at once stay within a single frame budget. Only touched on the game thread.
+		uint64 BudgetFrame = MAX_uint64;
+		double BudgetFrameSeconds = 0;
 
-			// Average of prev→current and current→next for a smoother direction hint.
-			// Closed loops have Nodes[ChainSize] == Nodes[0], so i+1 is always valid.
-			// Open chains: endpoints fall back to single-neighbor chord.
-			FVector Forward;
-			if (i == 0 && !Chain->bIsClosedLoop)
-			{
-				Forward = (Cluster->GetPos(Nodes[1]) - Position).GetSafeNormal();
-			}
-			else if (i == ChainSize - 1 && !Chain->bIsClosedLoop)
-			{
-				Forward = (Position - Cluster->GetPos(Nodes[i - 1])).GetSafeNormal();
-			}
-			else
+		double& GetFrameSpent()
+		{
+			if (BudgetFrame != GFrameCounter)
 			{
-				const int32 PrevIdx = (i == 0) ? ChainSize - 1 : i - 1;
-				const FVector DirPrev = (Position - Cluster->GetPos(Nodes[PrevIdx])).GetSafeNormal();
-				const FVector DirNext = (Cluster->GetPos(Nodes[i + 1]) - Position).GetSafeNormal();
-				Forward = (DirPrev + DirNext).GetSafeNormal();
-				if (Forward.IsNearlyZero()) { Forward = DirNext; }
+				BudgetFrame = GFrameCounter;
+				BudgetFrameSeconds = 0;
 			}
+			return BudgetFrameSeconds;
+		}
+	}
 
-			FZoneShapePoint ShapePoint = FZoneShapePoint(Position);
-			ShapePoint.SetRotationFromForwardAndUp(Forward, FVector::UpVector);
+	FCompileScheduler::FCompileScheduler(FPCGExClusterToZoneGraphContext* InContext, const double InBudgetSeconds, const bool bInLogStats)
+		: Context(InContext), bLogStats(bInLogStats)
+	{
+		Budget.BudgetSeconds = InBudgetSeconds;
+	}
 
-			if (Processor->RoadPointTypeBuffer)
-			{
-				ShapePoint.Type = static_cast<FZoneShapePointType>(FMath::Clamp(Processor->RoadPointTypeBuffer->Read(NodePointIndex), 0, 3));
-			}
-			else
-			{
-				ShapePoint.Type = DefaultPointType;
-			}
+	void FCompileScheduler::Enqueue(const TSharedPtr<FProcessor>& InProcessor, const TSharedPtr<PCGExMT::FTaskManager>& InTaskManager)
+	{
+		{
+			FScopeLock Lock(&QueueLock);
+			Queue.Add(InProcessor);
+			NumProcessors++;
+			PeakQueueDepth = FMath::Max(PeakQueueDepth, Queue.Num());
+		}
 
-			if (S->RoadTangentLengthMode == EPCGExZGTangentLengthMode::Manual && Processor->TangentLengthGetter)
-			{
-				ShapePoint.TangentLength = Processor->TangentLengthGetter->Read(NodePointIndex) * S->TangentLengthScale;
-			}
+		// Processors share the context task manager, the first one in starts the slice chain
+		Wake(InTaskManager);
+	}
 
-			PrecomputedPoints[i] = ShapePoint;
+	void FCompileScheduler::Wake(const TSharedPtr<PCGExMT::FTaskManager>& InTaskManager)
+	{
+		{
+			FScopeLock Lock(&QueueLock);
+			if (bRunning) { return; }
+			bRunning = true;
 		}
 
-		const PCGExClusters::FNode* FirstNode = Cluster->GetNode(Nodes[0]);
-		const PCGExClusters::FNode* LastNode = Cluster->GetNode(Nodes.Last());
+		StartSlice(InTaskManager);
+	}
+
+	int32 FCompileScheduler::GetQueueDepth() const
+	{
+		FScopeLock Lock(&QueueLock);
+		return Queue.Num();
+	}
+
+	void FCompileScheduler::StartSlice(const TSharedPtr<PCGExMT::FTaskManager>& InTaskManager)
+	{
+		// Each slice is a single main-thread iteration, chained from the previous slice's completion.
+		// This keeps the task manager from completing and lands each slice on its own tick.
+		// The previous slice is kept alive since this may run from within its own completion.
+		PreviousSlice = CurrentSlice;
+		CurrentSlice = MakeShared<PCGExMT::FTimeSlicedMainThreadLoop>(1);
+		CurrentSlice->OnIterationCallback = [PCGEX_ASYNC_THIS_CAPTURE](const int32 Index, const PCGExMT::FScope& Scope)
+		{
+			PCGEX_ASYNC_THIS
+			This->RunSlice();
+		};
 
-		if (!Chain->bIsClosedLoop)
+		TWeakPtr<PCGExMT::FTaskManager> WeakTaskManager = InTaskManager;
+		CurrentSlice->OnCompleteCallback = [PCGEX_ASYNC_THIS_CAPTURE, WeakTaskManager]()
 		{
-			const bool bTrim = S->bTrimRoadEndpoints;
-			const double BufferSq = S->EndpointTrimBuffer * S->EndpointTrimBuffer;
+			PCGEX_ASYNC_THIS
 
-			// --- Start endpoint ---
-			if (!FirstNode->IsLeaf())
 			{
-				if (StartEndpoint.bValid && bTrim)
+				FScopeLock Lock(&This->QueueLock);
+				if (This->Queue.IsEmpty())
 				{
-					// Walk backward from end to find the outermost half-space boundary crossing.
-					bool bFoundCrossing = false;
-
-					for (int32 j = PrecomputedPoints.Num() - 1; j > 0; j--)
-					{
-						const double ProjJ = (PrecomputedPoints[j].Position - StartEndpoint.PolygonCenter) | StartEndpoint.Direction;
-						const double ProjPrev = (PrecomputedPoints[j - 1].Position - StartEndpoint.PolygonCenter) | StartEndpoint.Direction;
-
-						if (ProjJ >= StartEndpoint.Radius && ProjPrev < StartEndpoint.Radius)
-						{
-							// Capture tangent lengths before removal for interpolation
-							const double TL_Prev = PrecomputedPoints[j - 1].TangentLength;
-							const double TL_J = PrecomputedPoints[j].TangentLength;
-
-							PrecomputedPoints.RemoveAt(0, j);
-
-							// Snap to polygon connector position for exact alignment
-							const FVector SnapPos = StartEndpoint.PolygonCenter + StartEndpoint.Direction * StartEndpoint.Radius;
-							FVector CrossingDir = (PrecomputedPoints[0].Position - SnapPos).GetSafeNormal();
-							if (CrossingDir.IsNearlyZero()) { CrossingDir = StartEndpoint.Direction; }
-
-							FZoneShapePoint CrossingPoint(SnapPos);
-							CrossingPoint.SetRotationFromForwardAndUp(CrossingDir, FVector::UpVector);
-							CrossingPoint.Type = DefaultPointType;
-
-							if (S->RoadTangentLengthMode == EPCGExZGTangentLengthMode::Manual)
-							{
-								const double Alpha = (StartEndpoint.Radius - ProjPrev) / (ProjJ - ProjPrev);
-								CrossingPoint.TangentLength = FMath::Lerp(TL_Prev, TL_J, Alpha);
-							}
-
-							PrecomputedPoints.Insert(CrossingPoint, 0);
-
-							// Remove nearby points that would cause auto-bezier bulging
-							if (BufferSq > 0)
-							{
-								while (PrecomputedPoints.Num() > 2 &&
-									(PrecomputedPoints[1].Position - PrecomputedPoints[0].Position).SizeSquared() < BufferSq)
-								{
-									PrecomputedPoints.RemoveAt(1);
-								}
-							}
-
-							bFoundCrossing = true;
-							break;
-						}
-					}
-
-					if (!bFoundCrossing)
-					{
-						const double FirstProj = (PrecomputedPoints[0].Position - StartEndpoint.PolygonCenter) | StartEndpoint.Direction;
-						if (FirstProj < StartEndpoint.Radius)
-						{
-							bDegenerate = true;
-							return;
-						}
-					}
+					This->bRunning = false;
+					This->LogStats();
+					return;
 				}
-				else
+
+				// Nothing can compile until a window lands, the chain stops and the window completion wakes it back up
+				if (!This->Queue.ContainsByPredicate([](const TSharedPtr<FProcessor>& Processor) { return !Processor->IsWaitingForWindow(); }))
 				{
-					if (bIsReversed) { PrecomputedPoints[0].Position += PrecomputedPoints[0].Rotation.RotateVector(FVector::BackwardVector) * StartRadius; }
-					else { PrecomputedPoints[0].Position += PrecomputedPoints[0].Rotation.RotateVector(FVector::ForwardVector) * StartRadius; }
+					This->bRunning = false;
+					return;
 				}
 			}
 
-			// --- End endpoint ---
-			if (!LastNode->IsLeaf())
+			if (const TSharedPtr<PCGExMT::FTaskManager> PinnedTaskManager = WeakTaskManager.Pin()) { This->StartSlice(PinnedTaskManager); }
+		};
+
+		PCGEX_ASYNC_HANDLE_CHKD_VOID(InTaskManager, CurrentSlice)
+	}
+
+	void FCompileScheduler::RunSlice()
+	{
+		double& FrameSpent = GetFrameSpent();
+
+		// Another node may already have used up this frame's budget
+		if (FrameSpent >= Budget.BudgetSeconds) { return; }
+
+		TArray<TSharedPtr<FProcessor>> Pending;
+		{
+			FScopeLock Lock(&QueueLock);
+			Pending = Queue;
+		}
+
+		// Least remaining work first, so small clusters get through and release their outputs early
+		Pending.StableSort([](const TSharedPtr<FProcessor>& A, const TSharedPtr<FProcessor>& B) { return A->GetRemainingShapes() < B->GetRemainingShapes(); });
+
+		const double SliceStart = FPlatformTime::Seconds();
+		const double StartSpent = FrameSpent;
+		double Spent = StartSpent;
+		bool bOutOfBudget = false;
+
+		for (const TSharedPtr<FProcessor>& Processor : Pending)
+		{
+			const bool bPrepared = Processor->PrepareCompile();
+			if (bPrepared)
 			{
-				if (EndEndpoint.bValid && bTrim)
+				while (Processor->GetRemainingShapes() > 0)
 				{
-					// Walk backward from end to find the outermost half-space boundary crossing.
-					// Walking backward (not forward) prevents removing valid outside points
-					// that appear after an intermediate inside dip on curved roads.
-					bool bFoundCrossing = false;
+					// Size the next batch from the cost estimate, stopping before it is expected to overrun the budget.
+					// A fresh frame always makes progress, with a single shape when there is no estimate yet.
+					const bool bPolygon = Processor->IsNextShapePolygon();
+					const double Estimate = Budget.Estimate(bPolygon);
 
-					for (int32 j = PrecomputedPoints.Num() - 1; j > 0; j--)
+					int32 BatchSize = Estimate > 0 ? FMath::FloorToInt32((Budget.BudgetSeconds - Spent) / Estimate) : 1;
+					if (BatchSize <= 0)
 					{
-						const double ProjJ = (PrecomputedPoints[j].Position - EndEndpoint.PolygonCenter) | EndEndpoint.Direction;
-						const double ProjPrev = (PrecomputedPoints[j - 1].Position - EndEndpoint.PolygonCenter) | EndEndpoint.Direction;
-
-						if (ProjJ < EndEndpoint.Radius && ProjPrev >= EndEndpoint.Radius)
+						if (Spent > 0)
 						{
-							// Capture tangent lengths before removal for interpolation
-							const double TL_Prev = PrecomputedPoints[j - 1].TangentLength;
-							const double TL_J = PrecomputedPoints[j].TangentLength;
-
-							PrecomputedPoints.RemoveAt(j, PrecomputedPoints.Num() - j);
-
-							// Snap to polygon connector position for exact alignment
-							const FVector SnapPos = EndEndpoint.PolygonCenter + EndEndpoint.Direction * EndEndpoint.Radius;
-							FVector CrossingDir = (SnapPos - PrecomputedPoints.Last().Position).GetSafeNormal();
-							if (CrossingDir.IsNearlyZero()) { CrossingDir = -EndEndpoint.Direction; }
-
-							FZoneShapePoint CrossingPoint(SnapPos);
-							CrossingPoint.SetRotationFromForwardAndUp(CrossingDir, FVector::UpVector);
-							CrossingPoint.Type = DefaultPointType;
-
-							if (S->RoadTangentLengthMode == EPCGExZGTangentLengthMode::Manual)
-							{
-								const double Alpha = (EndEndpoint.Radius - ProjPrev) / (ProjJ - ProjPrev);
-								CrossingPoint.TangentLength = FMath::Lerp(TL_Prev, TL_J, Alpha);
-							}
-
-							PrecomputedPoints.Add(CrossingPoint);
-
-							// Remove nearby points that would cause auto-bezier bulging
-							if (BufferSq > 0)
-							{
-								while (PrecomputedPoints.Num() > 2 &&
-									(PrecomputedPoints[PrecomputedPoints.Num() - 2].Position - PrecomputedPoints.Last().Position).SizeSquared() < BufferSq)
-								{
-									PrecomputedPoints.RemoveAt(PrecomputedPoints.Num() - 2);
-								}
-							}
-
-							bFoundCrossing = true;
+							bOutOfBudget = true;
 							break;
 						}
+
+						BatchSize = 1;
 					}
 
-					if (!bFoundCrossing)
+					const double BatchStart = FPlatformTime::Seconds();
+					const int32 NumBatchCompiled = Processor->CompileShapes(FMath::Min(BatchSize, FCompileBudget::MaxBatchSize));
+					const double BatchEnd = FPlatformTime::Seconds();
+
+					if (NumBatchCompiled > 0)
 					{
-						const double LastProj = (PrecomputedPoints.Last().Position - EndEndpoint.PolygonCenter) | EndEndpoint.Direction;
-						if (LastProj < EndEndpoint.Radius)
-						{
-							bDegenerate = true;
-							return;
-						}
+						Budget.Record(bPolygon, (BatchEnd - BatchStart) / NumBatchCompiled);
+						NumCompiled += NumBatchCompiled;
 					}
-				}
-				else
-				{
-					if (bIsReversed) { PrecomputedPoints.Last().Position += PrecomputedPoints.Last().Rotation.RotateVector(FVector::ForwardVector) * EndRadius; }
-					else { PrecomputedPoints.Last().Position += PrecomputedPoints.Last().Rotation.RotateVector(FVector::BackwardVector) * EndRadius; }
+
+					Spent = StartSpent + (BatchEnd - SliceStart);
 				}
 			}
 
-			// Failsafe: ZoneGraph requires at least 2 shape points
-			if (PrecomputedPoints.Num() < 2)
+			if (bOutOfBudget) { break; }
+
+			// Streaming processors stay queued while their next window is precomputed
+			if (bPrepared && Processor->HasPendingWindows())
+			{
+				Processor->StartNextWindow();
+				continue;
+			}
+
 			{
-				bDegenerate = true;
+				FScopeLock Lock(&QueueLock);
+				Queue.Remove(Processor);
 			}
+
+			Processor->OnCompileComplete();
+		}
+
+		FrameSpent = Spent;
+		Budget.RecordTick(Spent - StartSpent);
+	}
+
+	bool FCompileScheduler::RunBudgeted(const TFunctionRef<bool()>& Step)
+	{
+		double& FrameSpent = GetFrameSpent();
+		if (FrameSpent >= Budget.BudgetSeconds) { return false; }
+
+		const double SliceStart = FPlatformTime::Seconds();
+		const double StartSpent = FrameSpent;
+
+		bool bPending = true;
+		while (bPending && FrameSpent < Budget.BudgetSeconds)
+		{
+			bPending = Step();
+			FrameSpent = StartSpent + (FPlatformTime::Seconds() - SliceStart);
 		}
 
-		// --- Auto/CatmullRom tangent pass ---
-		// Computed from final PrecomputedPoints positions (after trimming, crossing points included).
-		// Also overrides rotation with smooth tangent direction for Bezier point types.
-		if (!bDegenerate && (S->RoadTangentLengthMode == EPCGExZGTangentLengthMode::Auto || S->RoadTangentLengthMode == EPCGExZGTangentLengthMode::CatmullRom))
+		return !bPending;
+	}
+
+	void FCompileScheduler::LogStats() const
+	{
+		if (!bLogStats || Budget.NumTicks == 0) { return; }
+
+		PCGE_LOG_C(
+			Log, LogOnly, Context,
+			FText::Format(
+				FTEXT("Compiled {0} zone shapes from {1} clusters over {2} ticks: {3}ms per tick on average, {4}ms worst tick, {5} clusters queued at peak, {6} shapes updated in place, {7} left untouched."),
+				FText::AsNumber(NumCompiled),
+				FText::AsNumber(NumProcessors),
+				FText::AsNumber(Budget.NumTicks),
+				FText::AsNumber(Budget.TotalSeconds * 1000 / Budget.NumTicks),
+				FText::AsNumber(Budget.WorstTickSeconds * 1000),
+				FText::AsNumber(PeakQueueDepth),
+				FText::AsNumber(Context->NumUpdatedShapes),
+				FText::AsNumber(Context->NumUnchangedShapes)));
+
+		PCGE_LOG_C(
+			Log, LogOnly, Context,
+			FText::Format(
+				FTEXT("Peak shape staging memory: {0}MB."),
+				FText::AsNumber(static_cast<double>(Context->PeakStagingBytes.load()) / (1024 * 1024))));
+
+		if (Context->bUseChainCache)
 		{
-			const int32 Num = PrecomputedPoints.Num();
-			const bool bLoop = Chain->bIsClosedLoop;
-			const double Scale = S->TangentLengthScale;
-			const bool bCatmullRom = (S->RoadTangentLengthMode == EPCGExZGTangentLengthMode::CatmullRom);
+			const FChainCache::FStats ChainStats = FChainCache::Get().GetStats();
+			PCGE_LOG_C(
+				Log, LogOnly, Context,
+				FText::Format(
+					FTEXT("Chain cache: {0} clusters reused their chains, {1} skipped filtering. {2} clusters cached using {3}MB, {4} evictions overall."),
+					FText::AsNumber(Context->NumChainHits.GetValue()),
+					FText::AsNumber(Context->NumFilterSkips.GetValue()),
+					FText::AsNumber(ChainStats.NumEntries),
+					FText::AsNumber(static_cast<double>(ChainStats.AllocatedSize) / (1024 * 1024)),
+					FText::AsNumber(ChainStats.NumEvictions)));
+		}
 
-			for (int32 k = 0; k < Num; k++)
-			{
-				FVector Prev, Next;
-				if (bLoop)
-				{
-					Prev = PrecomputedPoints[(k - 1 + Num) % Num].Position;
-					Next = PrecomputedPoints[(k + 1) % Num].Position;
-				}
-				else if (k == 0)
-				{
-					Next = PrecomputedPoints[1].Position;
-					Prev = PrecomputedPoints[0].Position - (Next - PrecomputedPoints[0].Position); // mirror
-				}
-				else if (k == Num - 1)
-				{
-					Prev = PrecomputedPoints[Num - 2].Position;
-					Next = PrecomputedPoints[Num - 1].Position + (PrecomputedPoints[Num - 1].Position - Prev); // mirror
-				}
-				else
-				{
-					Prev = PrecomputedPoints[k - 1].Position;
-					Next = PrecomputedPoints[k + 1].Position;
-				}
+		if (!Context->bUsePrecomputeCache) { return; }
+
+		const FPrecomputeCache::FStats CacheStats = FPrecomputeCache::Get().GetStats();
+		PCGE_LOG_C(
+			Log, LogOnly, Context,
+			FText::Format(
+				FTEXT("Precompute cache: {0} clusters restored, {1} computed. {2} clusters cached using {3}MB, {4} hits, {5} misses and {6} evictions overall."),
+				FText::AsNumber(Context->NumPrecomputeHits.GetValue()),
+				FText::AsNumber(Context->NumPrecomputeMisses.GetValue()),
+				FText::AsNumber(CacheStats.NumEntries),
+				FText::AsNumber(static_cast<double>(CacheStats.AllocatedSize) / (1024 * 1024)),
+				FText::AsNumber(CacheStats.NumHits),
+				FText::AsNumber(CacheStats.NumMisses),
+				FText::AsNumber(CacheStats.NumEvictions)));
+	}
 
-				// Smooth tangent direction — override rotation
-				const FVector TangentDir = (Next - Prev).GetSafeNormal();
-				if (!TangentDir.IsNearlyZero())
-				{
-					PrecomputedPoints[k].SetRotationFromForwardAndUp(TangentDir, FVector::UpVector);
-				}
+	SIZE_T FPrecomputedShapes::GetAllocatedSize() const
+	{
+		SIZE_T Size = Chains.GetAllocatedSize() + Roads.GetAllocatedSize() + Polygons.GetAllocatedSize() + Connections.GetAllocatedSize();
+		for (const TSharedPtr<PCGExClusters::FNodeChain>& Chain : Chains) { Size += sizeof(PCGExClusters::FNodeChain) + Chain->Links.GetAllocatedSize(); }
 
-				// Tangent magnitude
-				if (bCatmullRom)
-				{
-					PrecomputedPoints[k].TangentLength = FVector::Dist(Prev, Next) / 6.0 * Scale;
-				}
-				else // Auto
-				{
-					const double DistPrev = FVector::Dist(PrecomputedPoints[k].Position, Prev);
-					const double DistNext = FVector::Dist(PrecomputedPoints[k].Position, Next);
-					PrecomputedPoints[k].TangentLength = (DistPrev + DistNext) * 0.5 / 3.0 * Scale;
-				}
-			}
+		return Size + ShapePoints.GetAllocatedSize();
+	}
+
+	SIZE_T FResolvedChains::GetAllocatedSize() const
+	{
+		SIZE_T Size = Breakpoints.GetAllocatedSize() + Chains.GetAllocatedSize();
+		for (const TSharedPtr<PCGExClusters::FNodeChain>& Chain : Chains) { Size += sizeof(PCGExClusters::FNodeChain) + Chain->Links.GetAllocatedSize(); }
+		return Size;
+	}
+
+	FZGBase::FZGBase(FProcessor* InProcessor)
+		: Processor(InProcessor)
+	{
+	}
+
+	void FZGBase::MaterializePoints(TArray<FZoneShapePoint>& OutPoints, const bool bWriteTangentLengths) const
+	{
+		const FShapePointBuffer& Staging = Processor->ShapePoints;
+
+		OutPoints.SetNum(NumPoints);
+		for (int32 i = 0; i < NumPoints; i++)
+		{
+			const int32 Index = PointOffset + i;
+
+			FZoneShapePoint& Point = OutPoints[i];
+			Point = FZoneShapePoint(Staging.Positions[Index]);
+			Point.Rotation = Staging.Rotations[Index];
+			Point.Type = Staging.Types[Index];
+			if (bWriteTangentLengths) { Point.TangentLength = Staging.TangentLengths[Index]; }
+		}
+	}
+
+	uint32 FZGBase::HashStagedPoints(const uint32 Seed) const
+	{
+		const FShapePointBuffer& Staging = Processor->ShapePoints;
+
+		uint32 Hash = FCrc::MemCrc32(Staging.Positions.GetData() + PointOffset, NumPoints * sizeof(FVector), Seed);
+		Hash = FCrc::MemCrc32(Staging.Forwards.GetData() + PointOffset, NumPoints * sizeof(FVector), Hash);
+		Hash = FCrc::MemCrc32(Staging.TangentLengths.GetData() + PointOffset, NumPoints * sizeof(float), Hash);
+		return FCrc::MemCrc32(Staging.Types.GetData() + PointOffset, NumPoints * sizeof(FZoneShapePointType), Hash);
+	}
+
+	void FZGBase::InitComponent(AActor* InTargetActor)
+	{
+		if (!InTargetActor)
+		{
+			PCGE_LOG_C(Error, GraphAndLog, Processor->GetContext(), FTEXT("Invalid target actor."));
+			return;
+		}
+
+		// This executes on the main thread for safety
+		FPCGExClusterToZoneGraphContext* Context = Processor->GetContext();
+		if (Processor->bReuseComponents)
+		{
+			// Reusable shapes are owned by their own managed resource rather than the context's managed objects
+			Component = NewObject<UZoneShapeComponent>(InTargetActor, Context->MakeComponentName(InTargetActor), Processor->CachedObjectFlags);
+			ManagedShape = NewObject<UPCGExManagedZoneShapeComponent>(const_cast<UPCGComponent*>(Context->GetComponent()));
+			ManagedShape->SetComponent(Component);
+			ManagedShape->ShapeId = ShapeId;
+			ManagedShape->ContentHash = ContentHash;
+			ManagedShape->BaseTags = Component->GetTags();
+		}
+		else
+		{
+			Component = Context->ManagedObjects->New<UZoneShapeComponent>(InTargetActor, Context->MakeComponentName(InTargetActor), Processor->CachedObjectFlags);
+		}
+
+		if (Component) { Component->ComponentTags.Append(Context->ComponentTags); }
+	}
+
+	bool FZGBase::KeepComponent(AActor* InTargetActor)
+	{
+		ManagedShape = Processor->GetContext()->ClaimReusableShape(ShapeId, InTargetActor);
+		if (!ManagedShape) { return false; }
+
+		Component = Cast<UZoneShapeComponent>(ManagedShape->GetComponent());
+		return true;
+	}
+
+	bool FZGBase::TryReuseComponent(AActor* InTargetActor, bool& bOutUnchanged)
+	{
+		ManagedShape = Processor->GetContext()->ClaimReusableShape(ShapeId, InTargetActor);
+		if (!ManagedShape) { return false; }
+
+		Component = Cast<UZoneShapeComponent>(ManagedShape->GetComponent());
+		bOutUnchanged = ManagedShape->ContentHash == ContentHash;
+		ManagedShape->ContentHash = ContentHash;
+		return true;
+	}
+
+	FZGRoad::FZGRoad(FProcessor* InProcessor, PCGExClusters::FNodeChain* InChain, const bool InReverse)
+		: FZGBase(InProcessor), Chain(InChain), bIsReversed(InReverse)
+	{
+	}
+
+	void FZGRoad::ResolveLaneProfile(const TSharedPtr<PCGExClusters::FCluster>& Cluster, FPrecomputeScratch& Scratch)
+	{
+		if (Processor->EdgeLaneProfiles.IsEmpty())
+		{
+			LaneProfileIndex = 0;
+			return;
+		}
+
+		LaneProfileIndex = Kernels::VoteLaneProfile(Chain->Links, Processor->EdgeLaneProfiles, Processor->NumLaneProfileBuckets, Scratch);
+
+		// Buckets past the interned table are unregistered names
+		if (LaneProfileIndex >= Processor->Context->LaneProfiles.Num()) { LaneProfileIndex = 0; }
+	}
+
+	void FZGRoad::Precompute(const TSharedPtr<PCGExClusters::FCluster>& Cluster, FPrecomputeScratch& Scratch)
+	{
+		(this->*Processor->RoadKernels[Chain->bIsClosedLoop ? 1 : 0])(Cluster, Scratch);
+
+		if (bDegenerate) { return; }
+
+		if (Processor->bReuseComponents)
+		{
+			ContentHash = HashCombineFast(HashStagedPoints(Processor->ShapeSettingsHash), GetTypeHash(Processor->GetLaneProfile(LaneProfileIndex).Profile.ID));
+		}
+	}
+
+	template <bool bHasTypeBuffer, ERoadTangentKernel TangentKernel, bool bTrim, bool bClosedLoop>
+	void FZGRoad::PrecomputeImpl(const TSharedPtr<PCGExClusters::FCluster>& Cluster, FPrecomputeScratch& Scratch)
+	{
+		TArray<int32>& Nodes = Scratch.Nodes;
+		Nodes.Reset();
+		const int32 ChainSize = Chain->GetNodes(Cluster, Nodes, bIsReversed);
+
+		// Single-edge chains: GetNodes uses edge Start/End topology which may not match
+		// the chain's Seed/Last ordering. Fix ordering for correct endpoint processing.
+		if (!bClosedLoop && ChainSize == 2)
+		{
+			const int32 ExpectedFirst = bIsReversed ? Chain->Links.Last().Node : Chain->Seed.Node;
+			if (Nodes[0] != ExpectedFirst) { Swap(Nodes[0], Nodes[1]); }
 		}
+
+		PrecomputeNodes<bHasTypeBuffer, TangentKernel, bTrim, bClosedLoop>(Kernels::FClusterNodes(Cluster.Get()), Processor->RoadParams, Scratch);
 	}
 
 	void FZGRoad::Compile()
 	{
 		Component->SetShapeType(FZoneShapeType::Spline);
-		Component->SetCommonLaneProfile(CachedLaneProfile);
-		Component->GetMutablePoints() = MoveTemp(PrecomputedPoints);
-		Component->UpdateShape();
+		Component->SetCommonLaneProfile(Processor->GetLaneProfile(LaneProfileIndex).Profile);
+		MaterializePoints(Component->GetMutablePoints(), Processor->GetSettings()->RoadTangentLengthMode != EPCGExZGTangentLengthMode::Default);
+	}
+
+	void FZGRoad::Bake(PCGExZoneShapeBake::FChunk& OutChunk, TArray<FZoneShapePoint>& Scratch) const
+	{
+		MaterializePoints(Scratch, Processor->GetSettings()->RoadTangentLengthMode != EPCGExZGTangentLengthMode::Default);
+
+		PCGExZoneShapeBake::FShape Shape;
+		Shape.ShapeId = ShapeId;
+		Shape.Type = PCGExZoneShapeBake::EShapeType::Spline;
+		Shape.LaneProfile = LaneProfileIndex;
+		Shape.StartShape = StartPolygon; // Every polygon is baked first, in slot order
+		Shape.EndShape = EndPolygon;
+		OutChunk.AddShape(Shape, Scratch);
+	}
+
+	int32 FZGRoad::Emit(PCGExZoneGraphStorage::FChunk& OutChunk, TArray<FZoneShapePoint>& Scratch) const
+	{
+		MaterializePoints(Scratch, Processor->GetSettings()->RoadTangentLengthMode != EPCGExZGTangentLengthMode::Default);
+
+		const FPCGExClusterToZoneGraphContext* Context = Processor->GetContext();
+		return OutChunk.AddSpline(Scratch, Context->StorageLaneProfiles[LaneProfileIndex], Context->StorageDefaultTags);
 	}
 
 	void FZGRoad::BuildPathOutput(const TSharedPtr<PCGExData::FPointIO>& InPathIO) const
 	{
 		const auto* S = Processor->GetSettings();
 		const TArrayView<const FZoneShapePoint> Points = Component->GetPoints();
-		const int32 NumPoints = Points.Num();
+		const int32 NumPathPoints = Points.Num();
 
-		PCGExPointArrayDataHelpers::SetNumPointsAllocated(InPathIO->GetOut(), NumPoints);
+		PCGExPointArrayDataHelpers::SetNumPointsAllocated(InPathIO->GetOut(), NumPathPoints);
 		TPCGValueRange<FTransform> Transforms = InPathIO->GetOut()->GetTransformValueRange();
 
-		for (int32 i = 0; i < NumPoints; i++)
+		for (int32 i = 0; i < NumPathPoints; i++)
 		{
 			const FZoneShapePoint& Pt = Points[i];
 			Transforms[i] = FTransform(Pt.Rotation, Pt.Position);
@@ -522,7 +1230,7 @@ namespace PCGExClusterToZoneGraph
 		TSharedPtr<PCGExData::TBuffer<FVector>> ArriveWriter = PathFacade->GetWritable<FVector>(S->ArriveName, FVector::ZeroVector, true, PCGExData::EBufferInit::New);
 		TSharedPtr<PCGExData::TBuffer<FVector>> LeaveWriter = PathFacade->GetWritable<FVector>(S->LeaveName, FVector::ZeroVector, true, PCGExData::EBufferInit::New);
 
-		for (int32 i = 0; i < NumPoints; i++)
+		for (int32 i = 0; i < NumPathPoints; i++)
 		{
 			const FZoneShapePoint& Pt = Points[i];
 			const FVector Forward = Pt.Rotation.RotateVector(FVector::ForwardVector);
@@ -538,19 +1246,17 @@ namespace PCGExClusterToZoneGraph
 	FZGPolygon::FZGPolygon(FProcessor* InProcessor, const PCGExClusters::FNode* InNode)
 		: FZGBase(InProcessor), NodeIndex(InNode->Index)
 	{
-		FromStart.Init(false, InNode->Num());
-		Roads.Reserve(InNode->Num());
 	}
 
-	void FZGPolygon::Add(const TSharedPtr<FZGRoad>& InRoad, bool bFromStart)
+	TArrayView<FZGConnection> FZGPolygon::GetConnections() const
 	{
-		FromStart[Roads.Add(InRoad)] = bFromStart;
+		return MakeArrayView(Processor->Connections.GetData() + FirstConnection, NumConnections);
 	}
 
 	void FZGPolygon::Precompute(const TSharedPtr<PCGExClusters::FCluster>& Cluster)
 	{
 		const auto* S = Processor->GetSettings();
-		const auto* P = Processor;
+		FProcessor* P = Processor;
 		const PCGExClusters::FNode* Center = Cluster->GetNode(NodeIndex);
 		const int32 PointIndex = Center->PointIndex;
 		const FVector CenterPosition = Cluster->GetPos(Center);
@@ -559,18 +1265,19 @@ namespace PCGExClusterToZoneGraph
 		CachedRoutingType = P->PolygonRoutingTypeBuffer ? static_cast<EZoneShapePolygonRoutingType>(FMath::Clamp(P->PolygonRoutingTypeBuffer->Read(PointIndex), 0, 1)) : S->PolygonRoutingType;
 		CachedPointType = P->PolygonPointTypeBuffer ? static_cast<FZoneShapePointType>(FMath::Clamp(P->PolygonPointTypeBuffer->Read(PointIndex), 0, 3)) : S->PolygonPointType;
 		CachedAdditionalTags = P->AdditionalIntersectionTagsBuffer ? FZoneGraphTagMask(static_cast<uint32>(P->AdditionalIntersectionTagsBuffer->Read(PointIndex))) : S->AdditionalIntersectionTags;
-		CachedLaneProfile = S->LaneProfile;
+
+		const TArrayView<FZGConnection> Connections = GetConnections();
 
 		// Compute per-road radii based on auto-radius mode
-		CachedRoadRadii.SetNum(Roads.Num());
-		for (int32 i = 0; i < Roads.Num(); i++)
+		for (FZGConnection& Connection : Connections)
 		{
 			double Radius = CachedRadius;
 
 			if (S->AutoRadiusMode != EPCGExZGAutoRadiusMode::Disabled)
 			{
-				const double MaxLane = Roads[i]->CachedMaxLaneWidth;
-				const double HalfProfile = Roads[i]->CachedTotalProfileWidth * 0.5;
+				const FLaneProfileEntry& RoadProfile = P->GetLaneProfile(P->Roads[Connection.Road].LaneProfileIndex);
+				const double MaxLane = RoadProfile.MaxLaneWidth;
+				const double HalfProfile = RoadProfile.TotalWidth * 0.5;
 
 				switch (S->AutoRadiusMode)
 				{
@@ -590,346 +1297,1686 @@ namespace PCGExClusterToZoneGraph
 				}
 			}
 
-			CachedRoadRadii[i] = Radius;
+			Connection.Radius = Radius;
+		}
+
+		// Sort the connection range in place by heading, counter-clockwise; afterward, connection i maps to shape point i
+		Connections.Sort([](const FZGConnection& A, const FZGConnection& B) { return A.AngleKey < B.AngleKey; });
+
+		FShapePointBuffer& Staging = P->ShapePoints;
+		NumPoints = NumConnections;
+
+		for (int i = 0; i < NumConnections; i++)
+		{
+			const FZGConnection& Connection = Connections[i];
+			FZGRoad& Road = P->Roads[Connection.Road];
+			const FVector& RoadDirection = Connection.Direction;
+
+			// Store polygon boundary data on the road for precise intersection
+			FZGRoad::FPolygonEndpoint EP;
+			EP.PolygonCenter = CenterPosition;
+			EP.Direction = RoadDirection;
+			EP.Radius = Connection.Radius;
+			EP.bValid = true;
+
+			if (Connection.bFromStart) { Road.StartEndpoint = EP; }
+			else { Road.EndEndpoint = EP; }
+
+			const int32 StagedIndex = PointOffset + i;
+			Staging.Positions[StagedIndex] = CenterPosition + RoadDirection * Connection.Radius;
+			Staging.Forwards[StagedIndex] = RoadDirection * -1;
+			Staging.TangentLengths[StagedIndex] = 0;
+			Staging.Types[StagedIndex] = CachedPointType;
+		}
+
+		Kernels::BuildRotations(Staging.Forwards.GetData() + PointOffset, Staging.Rotations.GetData() + PointOffset, NumPoints);
+
+		if (P->bReuseComponents)
+		{
+			uint32 Hash = HashCombineFast(HashStagedPoints(P->ShapeSettingsHash), HashCombineFast(static_cast<uint32>(CachedRoutingType), CachedAdditionalTags.GetValue()));
+			for (const FZGConnection& Connection : Connections) { Hash = HashCombineFast(Hash, GetTypeHash(P->GetLaneProfile(P->Roads[Connection.Road].LaneProfileIndex).Profile.ID)); }
+			ContentHash = Hash;
+		}
+	}
+
+	void FZGPolygon::SyncRadiusToRoads()
+	{
+		for (const FZGConnection& Connection : GetConnections())
+		{
+			if (Connection.bFromStart)
+			{
+				Processor->Roads[Connection.Road].StartRadius = Connection.Radius;
+			}
+			else
+			{
+				Processor->Roads[Connection.Road].EndRadius = Connection.Radius;
+			}
 		}
+	}
+
+	void FZGPolygon::BuildPathOutput(const TSharedPtr<PCGExData::FPointIO>& InPathIO) const
+	{
+		const TArrayView<const FZoneShapePoint> Points = Component->GetPoints();
+		const int32 NumPathPoints = Points.Num();
+		PCGExPointArrayDataHelpers::SetNumPointsAllocated(InPathIO->GetOut(), NumPathPoints * 2);
+
+		TPCGValueRange<FTransform> Transforms = InPathIO->GetOut()->GetTransformValueRange();
+		for (int32 i = 0; i < NumPathPoints; i++)
+		{
+			const FZoneShapePoint& Pt = Points[i];
+			const double HalfWidth = Pt.TangentLength;
+
+			const FVector Left = Pt.Position + Pt.Rotation.RotateVector(FVector::LeftVector) * HalfWidth;
+			const FVector Right = Pt.Position + Pt.Rotation.RotateVector(FVector::RightVector) * HalfWidth;
+
+			Transforms[i * 2] = FTransform(Pt.Rotation, Right);
+			Transforms[i * 2 + 1] = FTransform(Pt.Rotation, Left);
+		}
+	}
+
+	void FZGPolygon::Compile()
+	{
+		Component->SetShapeType(FZoneShapeType::Polygon);
+		Component->SetPolygonRoutingType(CachedRoutingType);
+		Component->SetTags((ManagedShape ? ManagedShape->BaseTags : Component->GetTags()) | CachedAdditionalTags);
+		Component->SetCommonLaneProfile(Processor->GetLaneProfile(0).Profile);
+
+		// Register per-point lane profiles so each polygon connection uses its road's profile.
+		// Each distinct interned profile is registered once, in order of first use.
+		TArray<FZoneShapePoint>& Points = Component->GetMutablePoints();
+		MaterializePoints(Points, false);
+
+		// Reused components carry the previous execution's per-point profiles
+		if (ManagedShape) { Component->GetMutablePerPointLaneProfiles().Reset(); }
+
+		const TArrayView<FZGConnection> Connections = GetConnections();
+
+		TArray<TPair<int32, uint8>, TInlineAllocator<8>> Registered;
+		for (int32 i = 0; i < Points.Num(); i++)
+		{
+			const int32 TableIndex = Processor->Roads[Connections[i].Road].LaneProfileIndex;
+			const TPair<int32, uint8>* Found = Registered.FindByPredicate([TableIndex](const TPair<int32, uint8>& Entry) { return Entry.Key == TableIndex; });
+			if (!Found)
+			{
+				const int32 ProfileIdx = Component->AddUniquePerPointLaneProfile(Processor->GetLaneProfile(TableIndex).Profile);
+				Found = &Registered.Emplace_GetRef(TableIndex, static_cast<uint8>(ProfileIdx));
+			}
+			Points[i].LaneProfile = Found->Value;
+		}
+	}
+
+	void FZGPolygon::Bake(PCGExZoneShapeBake::FChunk& OutChunk, TArray<FZoneShapePoint>& Scratch) const
+	{
+		MaterializePoints(Scratch, false);
+
+		PCGExZoneShapeBake::FShape Shape;
+		Shape.ShapeId = ShapeId;
+		Shape.Type = PCGExZoneShapeBake::EShapeType::Polygon;
+		Shape.RoutingType = static_cast<uint8>(CachedRoutingType);
+		Shape.AdditionalTags = CachedAdditionalTags.GetValue();
+		Shape.LaneProfile = 0;
+
+		const int32 FirstPoint = OutChunk.AddShape(Shape, Scratch);
+		const TArrayView<FZGConnection> Connections = GetConnections();
+		for (int32 i = 0; i < Scratch.Num(); i++)
+		{
+			OutChunk.Points[FirstPoint + i].LaneProfile = static_cast<uint16>(Processor->Roads[Connections[i].Road].LaneProfileIndex);
+		}
+	}
+
+	int32 FZGPolygon::Emit(PCGExZoneGraphStorage::FChunk& OutChunk, TArray<FZoneShapePoint>& Scratch, TArray<FZoneLaneProfile>& ProfileScratch) const
+	{
+		MaterializePoints(Scratch, false);
+
+		// One profile per point, each connection uses its road's profile
+		const FPCGExClusterToZoneGraphContext* Context = Processor->GetContext();
+		const TArrayView<FZGConnection> Connections = GetConnections();
+
+		ProfileScratch.Reset(Scratch.Num());
+		for (int32 i = 0; i < Scratch.Num(); i++) { ProfileScratch.Add(Context->StorageLaneProfiles[Processor->Roads[Connections[i].Road].LaneProfileIndex]); }
+
+		return OutChunk.AddPolygon(Scratch, CachedRoutingType, ProfileScratch, Context->StorageDefaultTags | CachedAdditionalTags);
+	}
+
+	namespace Kernels
+	{
+		template <bool bHasTypeBuffer, ERoadTangentKernel TangentKernel, bool bTrim>
+		void SetRoadKernels(FZGRoad::FPrecomputeKernel (&OutKernels)[2])
+		{
+			OutKernels[0] = &FZGRoad::PrecomputeImpl<bHasTypeBuffer, TangentKernel, bTrim, false>;
+			OutKernels[1] = &FZGRoad::PrecomputeImpl<bHasTypeBuffer, TangentKernel, bTrim, true>;
+		}
+
+		template <bool bHasTypeBuffer, ERoadTangentKernel TangentKernel>
+		void SetRoadKernelsForTrim(const bool bTrim, FZGRoad::FPrecomputeKernel (&OutKernels)[2])
+		{
+			if (bTrim) { SetRoadKernels<bHasTypeBuffer, TangentKernel, true>(OutKernels); }
+			else { SetRoadKernels<bHasTypeBuffer, TangentKernel, false>(OutKernels); }
+		}
+
+		template <bool bHasTypeBuffer>
+		void SetRoadKernelsForTangents(const ERoadTangentKernel TangentKernel, const bool bTrim, FZGRoad::FPrecomputeKernel (&OutKernels)[2])
+		{
+			switch (TangentKernel)
+			{
+			case ERoadTangentKernel::Manual:
+				SetRoadKernelsForTrim<bHasTypeBuffer, ERoadTangentKernel::Manual>(bTrim, OutKernels);
+				break;
+			case ERoadTangentKernel::ManualConstant:
+				SetRoadKernelsForTrim<bHasTypeBuffer, ERoadTangentKernel::ManualConstant>(bTrim, OutKernels);
+				break;
+			case ERoadTangentKernel::Auto:
+				SetRoadKernelsForTrim<bHasTypeBuffer, ERoadTangentKernel::Auto>(bTrim, OutKernels);
+				break;
+			case ERoadTangentKernel::CatmullRom:
+				SetRoadKernelsForTrim<bHasTypeBuffer, ERoadTangentKernel::CatmullRom>(bTrim, OutKernels);
+				break;
+			default:
+				SetRoadKernelsForTrim<bHasTypeBuffer, ERoadTangentKernel::None>(bTrim, OutKernels);
+				break;
+			}
+		}
+	}
+
+	void FProcessor::SelectRoadKernels()
+	{
+		RoadParams.Staging = &ShapePoints;
+		RoadParams.PointType = Settings->RoadPointType;
+		RoadParams.EndpointTrimBuffer = Settings->EndpointTrimBuffer;
+		RoadParams.TangentLengthScale = Settings->TangentLengthScale;
+		RoadParams.bFloatPrecisionTangents = Settings->bFloatPrecisionTangents;
+		RoadParams.PointTypeBuffer = RoadPointTypeBuffer.Get();
+		RoadParams.TangentLengthGetter = TangentLengthGetter.Get();
+
+		ERoadTangentKernel TangentKernel = ERoadTangentKernel::None;
+		switch (Settings->RoadTangentLengthMode)
+		{
+		case EPCGExZGTangentLengthMode::Manual:
+			if (!TangentLengthGetter) { break; }
+			if (TangentLengthGetter->IsConstant())
+			{
+				// Constant tangent lengths are read once rather than per point
+				RoadParams.ConstantTangentLength = TangentLengthGetter->Read(0) * Settings->TangentLengthScale;
+				TangentKernel = ERoadTangentKernel::ManualConstant;
+			}
+			else
+			{
+				TangentKernel = ERoadTangentKernel::Manual;
+			}
+			break;
+		case EPCGExZGTangentLengthMode::Auto:
+			TangentKernel = ERoadTangentKernel::Auto;
+			break;
+		case EPCGExZGTangentLengthMode::CatmullRom:
+			TangentKernel = ERoadTangentKernel::CatmullRom;
+			break;
+		default: break;
+		}
+
+		if (RoadPointTypeBuffer) { Kernels::SetRoadKernelsForTangents<true>(TangentKernel, Settings->bTrimRoadEndpoints, RoadKernels); }
+		else { Kernels::SetRoadKernelsForTangents<false>(TangentKernel, Settings->bTrimRoadEndpoints, RoadKernels); }
+	}
+
+	bool FProcessor::Process(const TSharedPtr<PCGExMT::FTaskManager>& InTaskManager)
+	{
+		TRACE_CPUPROFILER_EVENT_SCOPE(PCGExClusterToZoneGraph::Process);
+
+		if (!IProcessor::Process(InTaskManager)) { return false; }
+
+		if (!DirectionSettings.InitFromParent(ExecutionContext, GetParentBatch<FBatch>()->DirectionSettings, EdgeDataFacade)) { return false; }
+
+		if (Settings->bOverridePolygonRadius) { PolygonRadiusBuffer = VtxDataFacade->GetBroadcaster<double>(Settings->PolygonRadiusAttribute); }
+		if (Settings->bOverridePolygonRoutingType) { PolygonRoutingTypeBuffer = VtxDataFacade->GetBroadcaster<int32>(Settings->PolygonRoutingTypeAttribute); }
+		if (Settings->bOverridePolygonPointType) { PolygonPointTypeBuffer = VtxDataFacade->GetBroadcaster<int32>(Settings->PolygonPointTypeAttribute); }
+		if (Settings->bOverrideRoadPointType) { RoadPointTypeBuffer = VtxDataFacade->GetBroadcaster<int32>(Settings->RoadPointTypeAttribute); }
+		if (Settings->bOverrideAdditionalIntersectionTags) { AdditionalIntersectionTagsBuffer = VtxDataFacade->GetBroadcaster<int32>(Settings->AdditionalIntersectionTagsAttribute); }
+		if (Settings->bOverrideLaneProfile)
+		{
+			EdgeLaneProfileBuffer = EdgeDataFacade->GetBroadcaster<FName>(Settings->LaneProfileAttribute);
+			if (EdgeLaneProfileBuffer)
+			{
+				// Resolve edge profile names to interned indices once, ahead of the per-road vote
+				EdgeLaneProfiles.SetNumUninitialized(NumEdges);
+
+				PCGEX_ASYNC_GROUP_CHKD(TaskManager, ResolveEdgeLaneProfiles)
+
+				ResolveEdgeLaneProfiles->OnCompleteCallback =
+					[PCGEX_ASYNC_THIS_CAPTURE]()
+					{
+						PCGEX_ASYNC_THIS
+						This->AssignUnknownLaneProfileBuckets();
+					};
+
+				ResolveEdgeLaneProfiles->OnSubLoopStartCallback =
+					[PCGEX_ASYNC_THIS_CAPTURE](const PCGExMT::FScope& Scope)
+					{
+						PCGEX_ASYNC_THIS
+						PCGEX_SCOPE_LOOP(Index)
+						{
+							This->EdgeLaneProfiles[Index] = This->ResolveLaneProfileIndex(This->EdgeLaneProfileBuffer->Read(This->Cluster->GetEdge(Index)->PointIndex));
+						}
+					};
+
+				ResolveEdgeLaneProfiles->StartSubLoops(NumEdges, GetDefault<UPCGExGlobalSettings>()->GetClusterBatchChunkSize());
+			}
+		}
+
+		bCachePrecompute = Context->bUsePrecomputeCache;
+		bStreaming = Settings->bStreamShapes && !bCachePrecompute && !Context->BakeWriter && !Context->StorageWriter;
+		bReuseComponents = Settings->bReuseComponents && !Context->BakeWriter && !Context->StorageWriter;
+
+		{
+			// Component tags are only written on creation, so they're part of the identity rather than the content
+			// Hashed from strings, FName hashes don't hold across editor sessions
+			const FString NodeName = ExecutionContext->Node ? ExecutionContext->Node->GetFName().ToString() : FString();
+			const int32 IOIndex = VtxDataFacade->Source->IOIndex;
+
+			FXxHash64Builder Builder;
+			Builder.Update(*NodeName, NodeName.Len() * sizeof(TCHAR));
+			Builder.Update(*Settings->CommaSeparatedComponentTags, Settings->CommaSeparatedComponentTags.Len() * sizeof(TCHAR));
+			Builder.Update(&IOIndex, sizeof(int32));
+			ShapeIdSeed = Builder.Finalize().Hash;
+		}
+
+		if (bReuseComponents)
+		{
+			ShapeSettingsHash = HashCombineFast(GetTypeHash(Settings->RoadTangentLengthMode != EPCGExZGTangentLengthMode::Default), GetTypeHash(Context->LaneProfiles[0].Profile.ID));
+		}
+
+		if (Settings->RoadTangentLengthMode == EPCGExZGTangentLengthMode::Manual)
+		{
+			TangentLengthGetter = Settings->TangentLength.GetValueSetting();
+			if (!TangentLengthGetter->Init(VtxDataFacade, false)) { return false; }
+		}
+
+		bCacheChains = Context->bUseChainCache;
+		if (bCacheChains)
+		{
+			ChainKey = ComputeChainKey();
+			CachedChains = FChainCache::Get().Find(ChainKey);
+
+			if (CachedChains && VtxFiltersManager) { VtxCrc = VtxDataFacade->GetIn()->GetOrComputeCrc(true).GetValue(); }
+
+			// Same topology, filters and vtx data always resolve to the same breakpoints, filtering is skipped altogether.
+			// Breakpoints that don't line up with the filter cache are treated as a miss, chains then rebuild from freshly filtered ones.
+			const bool bBreakpointsMatch = CachedChains && (!VtxFilterCache || VtxFilterCache->Num() == CachedChains->Breakpoints.Num());
+			if (bBreakpointsMatch && (!VtxFiltersManager || CachedChains->VtxCrc == VtxCrc))
+			{
+				if (VtxFilterCache) { *VtxFilterCache = CachedChains->Breakpoints; }
+				if (VtxFiltersManager) { Context->NumFilterSkips.Increment(); }
+				return BuildChains();
+			}
+		}
+
+		if (VtxFiltersManager)
+		{
+			PCGEX_ASYNC_GROUP_CHKD(TaskManager, FilterBreakpoints)
+
+			FilterBreakpoints->OnCompleteCallback =
+				[PCGEX_ASYNC_THIS_CAPTURE]()
+				{
+					PCGEX_ASYNC_THIS
+					This->BuildChains();
+				};
+
+			FilterBreakpoints->OnSubLoopStartCallback =
+				[PCGEX_ASYNC_THIS_CAPTURE](const PCGExMT::FScope& Scope)
+				{
+					PCGEX_ASYNC_THIS
+					This->FilterVtxScope(Scope);
+				};
+
+			FilterBreakpoints->StartSubLoops(NumNodes, GetDefault<UPCGExGlobalSettings>()->GetClusterBatchChunkSize());
+		}
+		else
+		{
+			return BuildChains();
+		}
+
+		return true;
+	}
+
+	bool FProcessor::BuildChains()
+	{
+		if (bCachePrecompute)
+		{
+			// Breakpoints are resolved by now, so the key covers everything chains and shapes are built from
+			PrecomputeKey = ComputePrecomputeKey();
+			if (TryRestorePrecompute()) { return true; }
+		}
+
+		if (CachedChains && (!VtxFilterCache || *VtxFilterCache == CachedChains->Breakpoints))
+		{
+			// Breakpoints came out the same, chains are shared with the cache and never modified past their construction
+			Context->NumChainHits.Increment();
+			ProcessedChains = CachedChains->Chains;
+			Polygons.Reserve(NumNodes / 2);
+			return true;
+		}
+
+		bIsProcessorValid = PCGExClusters::ChainHelpers::GetOrBuildChains(
+			Cluster.ToSharedRef(),
+			ProcessedChains,
+			VtxFilterCache,
+			false);
+
+		if (!bIsProcessorValid) { return false; }
+
+		// Compact chains so chain indices double as road slots
+		ProcessedChains.RemoveAll([](const TSharedPtr<PCGExClusters::FNodeChain>& Chain) { return !Chain; });
+
+		if (bCacheChains) { StoreChains(); }
+
+		Polygons.Reserve(NumNodes / 2);
+
+		return bIsProcessorValid;
+	}
+
+	uint64 FProcessor::ComputeChainKey() const
+	{
+		// Chains only depend on topology and breakpoints, positions and attributes are left out
+		FXxHash64Builder Builder;
+		Builder.Update(&Context->ChainFilterHash, sizeof(uint64));
+		Builder.Update(&NumNodes, sizeof(int32));
+		Builder.Update(&NumEdges, sizeof(int32));
+
+		for (int32 i = 0; i < NumNodes; i++)
+		{
+			const int32 PointIndex = Cluster->GetNode(i)->PointIndex;
+			Builder.Update(&PointIndex, sizeof(int32));
+		}
+
+		for (int32 i = 0; i < NumEdges; i++)
+		{
+			const auto* Edge = Cluster->GetEdge(i);
+			const uint32 EdgeData[3] = {Edge->Start, Edge->End, static_cast<uint32>(Edge->PointIndex)};
+			Builder.Update(EdgeData, sizeof(EdgeData));
+		}
+
+		return Builder.Finalize().Hash;
+	}
+
+	void FProcessor::StoreChains()
+	{
+		const TSharedPtr<FResolvedChains> Resolved = MakeShared<FResolvedChains>();
+		if (VtxFiltersManager) { Resolved->VtxCrc = VtxCrc ? VtxCrc : VtxDataFacade->GetIn()->GetOrComputeCrc(true).GetValue(); }
+		if (VtxFilterCache) { Resolved->Breakpoints = *VtxFilterCache; }
+		Resolved->Chains = ProcessedChains;
+
+		FChainCache::Get().Add(ChainKey, Resolved, GetCacheMaxSize(CVarChainCacheMaxMB));
+	}
+
+	void FProcessor::CompleteWork()
+	{
+		if (ProcessedChains.IsEmpty())
+		{
+			bIsProcessorValid = false;
+			return;
+		}
+
+		if (bPrecomputeRestored)
+		{
+			// Restored shapes go to the same output as freshly precomputed ones
+			AssignShapeIds();
+			CompileEnd = Polygons.Num() + Roads.Num();
+			OnPrecomputeComplete();
+			return;
+		}
+
+		ChainReversed.Init(false, ProcessedChains.Num());
+
+		BuildConnectorTable();
+		StartConnectorPhase();
+	}
+
+	void FProcessor::BuildConnectorTable()
+	{
+		// One connector per non-leaf chain end, grouped by node in chain order.
+		// Leaf ends neither plug into a polygon nor take part in the orientation graph.
+		const int32 NumChains = ProcessedChains.Num();
+
+		ConnectorStart.Init(0, NumNodes + 1);
+
+		for (const TSharedPtr<PCGExClusters::FNodeChain>& Chain : ProcessedChains)
+		{
+			const int32 SN = Chain->Seed.Node;
+			const int32 EN = Chain->Links.Last().Node;
+
+			if (!Cluster->GetNode(SN)->IsLeaf()) { ConnectorStart[SN + 1]++; }
+			if (!Cluster->GetNode(EN)->IsLeaf()) { ConnectorStart[EN + 1]++; }
+		}
+
+		for (int32 i = 0; i < NumNodes; i++) { ConnectorStart[i + 1] += ConnectorStart[i]; }
+
+		Connections.SetNum(ConnectorStart[NumNodes]);
+
+		TArray<int32> Cursor(ConnectorStart.GetData(), NumNodes);
+		for (int32 i = 0; i < NumChains; i++)
+		{
+			const PCGExClusters::FNodeChain* Chain = ProcessedChains[i].Get();
+
+			const int32 SN = Chain->Seed.Node;
+			const int32 EN = Chain->Links.Last().Node;
+			const bool bSeedIsLeaf = Cluster->GetNode(SN)->IsLeaf();
+			const bool bEndIsLeaf = Cluster->GetNode(EN)->IsLeaf();
+
+			if (!bSeedIsLeaf) { Connections[Cursor[SN]++] = FZGConnection(i, true, bEndIsLeaf ? -1 : EN); }
+			if (!bEndIsLeaf) { Connections[Cursor[EN]++] = FZGConnection(i, false, bSeedIsLeaf ? -1 : SN); }
+		}
+	}
+
+	void FProcessor::StartConnectorPhase()
+	{
+		// Connector directions and angle keys are computed once here,
+		// rather than inside every polygon sort comparison.
+		if (Connections.IsEmpty())
+		{
+			StartOrientation();
+			return;
+		}
+
+		PCGEX_ASYNC_GROUP_CHKD_VOID(TaskManager, ConnectorDirections)
+
+		ConnectorDirections->OnCompleteCallback =
+			[PCGEX_ASYNC_THIS_CAPTURE]()
+			{
+				PCGEX_ASYNC_THIS
+				This->StartOrientation();
+			};
+
+		ConnectorDirections->OnSubLoopStartCallback =
+			[PCGEX_ASYNC_THIS_CAPTURE](const PCGExMT::FScope& Scope)
+			{
+				PCGEX_ASYNC_THIS
+				PCGEX_SCOPE_LOOP(Index)
+				{
+					FZGConnection& Connector = This->Connections[Index];
+					Connector.Direction = This->ProcessedChains[Connector.Road]->GetEdgeDir(This->Cluster, Connector.bAtSeed);
+					Connector.AngleKey = FMath::Atan2(Connector.Direction.Y, Connector.Direction.X);
+				}
+			};
+
+		ConnectorDirections->StartSubLoops(Connections.Num(), GetDefault<UPCGExGlobalSettings>()->GetClusterBatchChunkSize());
+	}
+
+	void FProcessor::StartOrientation()
+	{
+		if (Settings->OrientationMode == EPCGExZGOrientationMode::DepthFirst)
+		{
+			BuildOrientationGraph();
+			StartDepthAssignment();
+		}
+		else
+		{
+			StartChainOrientation();
+		}
+	}
+
+	void FProcessor::StartDepthAssignment()
+	{
+		// Each connected component owns a disjoint set of nodes, so BFS depth assignment
+		// can run for every component concurrently without touching shared depth entries.
+		if (ComponentSeeds.IsEmpty())
+		{
+			StartChainOrientation();
+			return;
+		}
+
+		if (Settings->bTiledProcessing)
+		{
+			// A single large component would serialize on one BFS, so expand every component level by level instead.
+			// Depths are hop distances from each seed, the same whatever order a level is expanded in.
+			Frontier = ComponentSeeds;
+			for (const int32 Seed : Frontier) { NodeDepth[Seed] = 0; }
+			FrontierDepth = 0;
+			StartFrontierLevel();
+			return;
+		}
+
+		PCGEX_ASYNC_GROUP_CHKD_VOID(TaskManager, DepthAssignment)
+
+		DepthAssignment->OnCompleteCallback =
+			[PCGEX_ASYNC_THIS_CAPTURE]()
+			{
+				PCGEX_ASYNC_THIS
+				This->StartChainOrientation();
+			};
+
+		DepthAssignment->OnSubLoopStartCallback =
+			[PCGEX_ASYNC_THIS_CAPTURE](const PCGExMT::FScope& Scope)
+			{
+				PCGEX_ASYNC_THIS
+				TArray<int32> Queue;
+				PCGEX_SCOPE_LOOP(Index) { This->AssignComponentDepths(This->ComponentSeeds[Index], Queue); }
+			};
+
+		DepthAssignment->StartSubLoops(ComponentSeeds.Num(), 1);
+	}
+
+	void FProcessor::StartFrontierLevel()
+	{
+		if (Frontier.IsEmpty())
+		{
+			Frontier.Empty();
+			NextFrontier.Empty();
+			StartChainOrientation();
+			return;
+		}
+
+		NextFrontier.Reset();
+
+		PCGEX_ASYNC_GROUP_CHKD_VOID(TaskManager, FrontierLevel)
+
+		FrontierLevel->OnCompleteCallback =
+			[PCGEX_ASYNC_THIS_CAPTURE]()
+			{
+				PCGEX_ASYNC_THIS
+				Swap(This->Frontier, This->NextFrontier);
+				This->FrontierDepth++;
+				This->StartFrontierLevel();
+			};
+
+		FrontierLevel->OnSubLoopStartCallback =
+			[PCGEX_ASYNC_THIS_CAPTURE](const PCGExMT::FScope& Scope)
+			{
+				PCGEX_ASYNC_THIS
+
+				const int32 NextDepth = This->FrontierDepth + 1;
+				TArray<int32> Reached;
+
+				PCGEX_SCOPE_LOOP(Index)
+				{
+					const int32 Current = This->Frontier[Index];
+					for (int32 c = This->ConnectorStart[Current]; c < This->ConnectorStart[Current + 1]; c++)
+					{
+						const int32 Other = This->Connections[c].Opposite;
+						if (Other == -1) { continue; }
+
+						// First claim wins, every claimant would write the same depth
+						if (FPlatformAtomics::InterlockedCompareExchange(&This->NodeDepth[Other], NextDepth, -1) == -1) { Reached.Add(Other); }
+					}
+				}
+
+				if (Reached.IsEmpty()) { return; }
+
+				FScopeLock Lock(&This->FrontierLock);
+				This->NextFrontier.Append(Reached);
+			};
+
+		FrontierLevel->StartSubLoops(Frontier.Num(), GetDefault<UPCGExGlobalSettings>()->GetClusterBatchChunkSize());
+	}
+
+	void FProcessor::StartChainOrientation()
+	{
+		PCGEX_ASYNC_GROUP_CHKD_VOID(TaskManager, ChainOrientation)
+
+		ChainOrientation->OnCompleteCallback =
+			[PCGEX_ASYNC_THIS_CAPTURE]()
+			{
+				PCGEX_ASYNC_THIS
+				This->BuildShapes();
+			};
+
+		ChainOrientation->OnSubLoopStartCallback =
+			[PCGEX_ASYNC_THIS_CAPTURE](const PCGExMT::FScope& Scope)
+			{
+				PCGEX_ASYNC_THIS
+				PCGEX_SCOPE_LOOP(Index) { This->ChainReversed[Index] = This->OrientChain(Index); }
+			};
+
+		ChainOrientation->StartSubLoops(ProcessedChains.Num(), GetDefault<UPCGExGlobalSettings>()->GetClusterBatchChunkSize());
+	}
+
+	void FProcessor::BuildShapes()
+	{
+		// Orientation scratch is no longer needed
+		NodeDepth.Empty();
+		ComponentSeeds.Empty();
+
+		if (Settings->bTiledProcessing)
+		{
+			StartTiledPolygonPhase();
+			return;
+		}
+
+		// Dense node -> polygon slot lookup, node indices are contiguous
+		PolygonSlots.Init(-1, NumNodes);
+
+		auto GetOrCreatePolygon = [&](const PCGExClusters::FNode* InNode) -> int32
+		{
+			int32& Slot = PolygonSlots[InNode->Index];
+			if (Slot == -1)
+			{
+				// A polygon owns its node's connector range
+				FZGPolygon& Polygon = Polygons.Emplace_GetRef(this, InNode);
+				Polygon.FirstConnection = ConnectorStart[InNode->Index];
+				Polygon.NumConnections = ConnectorStart[InNode->Index + 1] - Polygon.FirstConnection;
+				Slot = Polygons.Num() - 1;
+			}
+			return Slot;
+		};
+
+		const int32 NumChains = ProcessedChains.Num();
+
+		Roads.Reserve(NumChains);
+
+		for (int i = 0; i < NumChains; i++)
+		{
+			const TSharedPtr<PCGExClusters::FNodeChain>& Chain = ProcessedChains[i];
+			const bool bReverse = ChainReversed[i];
+
+			int32 StartNode = Chain->Seed.Node;
+			int32 EndNode = Chain->Links.Last().Node;
+			if (bReverse) { Swap(StartNode, EndNode); }
+
+			FZGRoad& Road = Roads.Emplace_GetRef(this, Chain.Get(), bReverse);
+
+			// Roaming closed loop, road only!
+			if (IsRoamingLoop(i)) { continue; }
+
+			const PCGExClusters::FNode* Start = Cluster->GetNode(StartNode);
+			const PCGExClusters::FNode* End = Cluster->GetNode(EndNode);
+
+			if (!Start->IsLeaf()) { Road.StartPolygon = GetOrCreatePolygon(Start); }
+			if (!End->IsLeaf()) { Road.EndPolygon = GetOrCreatePolygon(End); }
+		}
+
+		// Resolve connectors against road orientation.
+		// Lollipop chains (single breakpoint on closed loop) have seed==end node, and map seed to start regardless.
+		for (FZGConnection& Connector : Connections)
+		{
+			const PCGExClusters::FNodeChain* Chain = ProcessedChains[Connector.Road].Get();
+			const bool bLollipop = Chain->Seed.Node == Chain->Links.Last().Node;
+			Connector.bFromStart = bLollipop ? Connector.bAtSeed : Connector.bAtSeed != ChainReversed[Connector.Road];
+		}
+
+		FinalizeShapes();
+	}
+
+	bool FProcessor::IsRoamingLoop(const int32 ChainIndex) const
+	{
+		const PCGExClusters::FNodeChain* Chain = ProcessedChains[ChainIndex].Get();
+		return Chain->bIsClosedLoop && Cluster->GetNode(Chain->Seed.Node)->IsBinary() && Cluster->GetNode(Chain->Links.Last().Node)->IsBinary();
+	}
+
+	bool FProcessor::NeedsPolygon(const int32 NodeIndex) const
+	{
+		// Connectors only exist on non-leaf chain ends, so any of them on a road that isn't a roaming loop calls for a polygon
+		for (int32 c = ConnectorStart[NodeIndex]; c < ConnectorStart[NodeIndex + 1]; c++)
+		{
+			if (!IsRoamingLoop(Connections[c].Road)) { return true; }
+		}
+		return false;
+	}
+
+	void FProcessor::BuildTiles()
+	{
+		// Uniform XY grid sized for TileSize nodes per tile on average, filled with a stable counting sort
+		const int32 NumTargetTiles = FMath::DivideAndRoundUp(NumNodes, FMath::Max(1, Settings->TileSize));
+		const int32 GridSize = FMath::Max(1, FMath::CeilToInt32(FMath::Sqrt(static_cast<double>(NumTargetTiles))));
+		const int32 NumTiles = GridSize * GridSize;
+
+		FBox Bounds(ForceInit);
+		for (int32 i = 0; i < NumNodes; i++) { Bounds += Cluster->GetPos(i); }
+
+		const FVector Size = Bounds.GetSize();
+		const double ScaleX = Size.X > UE_SMALL_NUMBER ? GridSize / Size.X : 0;
+		const double ScaleY = Size.Y > UE_SMALL_NUMBER ? GridSize / Size.Y : 0;
+
+		TArray<int32> NodeTiles;
+		NodeTiles.SetNumUninitialized(NumNodes);
+		TileStarts.Init(0, NumTiles + 1);
+
+		for (int32 i = 0; i < NumNodes; i++)
+		{
+			const FVector Pos = Cluster->GetPos(i);
+			const int32 X = FMath::Clamp(FMath::FloorToInt32((Pos.X - Bounds.Min.X) * ScaleX), 0, GridSize - 1);
+			const int32 Y = FMath::Clamp(FMath::FloorToInt32((Pos.Y - Bounds.Min.Y) * ScaleY), 0, GridSize - 1);
+			NodeTiles[i] = Y * GridSize + X;
+			TileStarts[NodeTiles[i] + 1]++;
+		}
+
+		for (int32 t = 0; t < NumTiles; t++) { TileStarts[t + 1] += TileStarts[t]; }
+
+		TArray<int32> Cursors(TileStarts.GetData(), NumTiles);
+		TileNodes.SetNumUninitialized(NumNodes);
+		for (int32 i = 0; i < NumNodes; i++) { TileNodes[Cursors[NodeTiles[i]]++] = i; }
+	}
+
+	void RankPolygonOrderKeys(const TConstArrayView<int32> Keys, const int32 NumKeys, TArray<int32>& OutSlots)
+	{
+		// Keys are unique and bounded, so a prefix sum over used keys ranks them without sorting
+		TArray<int32> Ranks;
+		Ranks.Init(0, NumKeys + 1);
+		for (const int32 Key : Keys) { Ranks[Key + 1] = 1; }
+		for (int32 k = 0; k < NumKeys; k++) { Ranks[k + 1] += Ranks[k]; }
+
+		OutSlots.SetNumUninitialized(Keys.Num());
+		for (int32 i = 0; i < Keys.Num(); i++) { OutSlots[i] = Ranks[Keys[i]]; }
+	}
+
+	void FProcessor::StartTiledPolygonPhase()
+	{
+		// Every polygon belongs to the tile holding its node, so tiles count their polygons independently,
+		// get a contiguous slot range from a prefix sum and fill it in node order.
+		// Chains crossing tile borders never create anything, their roads look polygons up once slots are final.
+		BuildTiles();
+
+		const int32 NumTiles = TileStarts.Num() - 1;
+		PolygonSlots.Init(-1, NumNodes);
+		TilePolygonStarts.Init(0, NumTiles + 1);
+
+		PCGEX_ASYNC_GROUP_CHKD_VOID(TaskManager, TilePolygonCount)
+
+		TilePolygonCount->OnCompleteCallback =
+			[PCGEX_ASYNC_THIS_CAPTURE]()
+			{
+				PCGEX_ASYNC_THIS
+				This->StartTiledPolygonAssignment();
+			};
+
+		TilePolygonCount->OnSubLoopStartCallback =
+			[PCGEX_ASYNC_THIS_CAPTURE](const PCGExMT::FScope& Scope)
+			{
+				PCGEX_ASYNC_THIS
+				PCGEX_SCOPE_LOOP(Tile)
+				{
+					int32 Count = 0;
+					for (int32 n = This->TileStarts[Tile]; n < This->TileStarts[Tile + 1]; n++)
+					{
+						const int32 NodeIndex = This->TileNodes[n];
+						if (!This->NeedsPolygon(NodeIndex)) { continue; }
+
+						This->PolygonSlots[NodeIndex] = -2; // Pending, slot is assigned once ranges are known
+						Count++;
+					}
+					This->TilePolygonStarts[Tile + 1] = Count;
+				}
+			};
+
+		TilePolygonCount->StartSubLoops(NumTiles, 1);
+	}
+
+	void FProcessor::StartTiledPolygonAssignment()
+	{
+		const int32 NumTiles = TileStarts.Num() - 1;
+		for (int32 t = 0; t < NumTiles; t++) { TilePolygonStarts[t + 1] += TilePolygonStarts[t]; }
+
+		PCGEX_ASYNC_GROUP_CHKD_VOID(TaskManager, TilePolygonAssignment)
+
+		// Slots are constructed in place by their owning tile
+		Polygons.SetNumUninitialized(TilePolygonStarts[NumTiles]);
+		TilePolygonKeys.SetNumUninitialized(Polygons.Num());
+
+		TilePolygonAssignment->OnCompleteCallback =
+			[PCGEX_ASYNC_THIS_CAPTURE]()
+			{
+				PCGEX_ASYNC_THIS
+				This->OrderTiledPolygons();
+				This->StartTiledRoadPhase();
+			};
+
+		TilePolygonAssignment->OnSubLoopStartCallback =
+			[PCGEX_ASYNC_THIS_CAPTURE](const PCGExMT::FScope& Scope)
+			{
+				PCGEX_ASYNC_THIS
+				PCGEX_SCOPE_LOOP(Tile) { This->AssignTilePolygons(Tile); }
+			};
+
+		TilePolygonAssignment->StartSubLoops(NumTiles, 1);
+	}
+
+	void FProcessor::AssignTilePolygons(const int32 Tile)
+	{
+		int32 Slot = TilePolygonStarts[Tile];
+
+		for (int32 n = TileStarts[Tile]; n < TileStarts[Tile + 1]; n++)
+		{
+			const int32 NodeIndex = TileNodes[n];
+
+			// Connectors belong to their node, so the owning tile resolves them too
+			for (int32 c = ConnectorStart[NodeIndex]; c < ConnectorStart[NodeIndex + 1]; c++)
+			{
+				FZGConnection& Connector = Connections[c];
+				const PCGExClusters::FNodeChain* Chain = ProcessedChains[Connector.Road].Get();
+				const bool bLollipop = Chain->Seed.Node == Chain->Links.Last().Node;
+				Connector.bFromStart = bLollipop ? Connector.bAtSeed : Connector.bAtSeed != ChainReversed[Connector.Road];
+			}
+
+			if (PolygonSlots[NodeIndex] == -1) { continue; }
+
+			FZGPolygon* Polygon = new(Polygons.GetData() + Slot) FZGPolygon(this, Cluster->GetNode(NodeIndex));
+			Polygon->FirstConnection = ConnectorStart[NodeIndex];
+			Polygon->NumConnections = ConnectorStart[NodeIndex + 1] - Polygon->FirstConnection;
+
+			int32 Key = MAX_int32;
+			for (int32 c = ConnectorStart[NodeIndex]; c < ConnectorStart[NodeIndex + 1]; c++)
+			{
+				const FZGConnection& Connector = Connections[c];
+				if (!IsRoamingLoop(Connector.Road)) { Key = FMath::Min(Key, GetPolygonOrderKey(Connector.Road, Connector.bFromStart)); }
+			}
+
+			TilePolygonKeys[Slot] = Key;
+			PolygonSlots[NodeIndex] = Slot++;
+		}
+	}
+
+	void FProcessor::OrderTiledPolygons()
+	{
+		// Tiles fill their ranges in node order, polygons move back to the untiled order so slots,
+		// and everything indexed or identified by them, match the untiled result
+		TArray<int32> Ordered;
+		RankPolygonOrderKeys(TilePolygonKeys, ProcessedChains.Num() * 2, Ordered);
+
+		TArray<FZGPolygon> Sorted;
+		Sorted.SetNumUninitialized(Polygons.Num());
+		for (int32 i = 0; i < Polygons.Num(); i++)
+		{
+			PolygonSlots[Polygons[i].NodeIndex] = Ordered[i];
+			new(Sorted.GetData() + Ordered[i]) FZGPolygon(MoveTemp(Polygons[i]));
+		}
+
+		Polygons = MoveTemp(Sorted);
+		TilePolygonKeys.Empty();
+	}
+
+	void FProcessor::StartTiledRoadPhase()
+	{
+		const int32 NumChains = ProcessedChains.Num();
+
+		PCGEX_ASYNC_GROUP_CHKD_VOID(TaskManager, TiledRoadAssembly)
+
+		// Roads keep their chain slot, so they are constructed in place without any ordering concern
+		Roads.SetNumUninitialized(NumChains);
+
+		TiledRoadAssembly->OnCompleteCallback =
+			[PCGEX_ASYNC_THIS_CAPTURE]()
+			{
+				PCGEX_ASYNC_THIS
+				This->FinalizeShapes();
+			};
+
+		TiledRoadAssembly->OnSubLoopStartCallback =
+			[PCGEX_ASYNC_THIS_CAPTURE](const PCGExMT::FScope& Scope)
+			{
+				PCGEX_ASYNC_THIS
+				PCGEX_SCOPE_LOOP(Index) { This->AssembleTiledRoad(Index); }
+			};
+
+		TiledRoadAssembly->StartSubLoops(NumChains, GetDefault<UPCGExGlobalSettings>()->GetClusterBatchChunkSize());
+	}
+
+	void FProcessor::AssembleTiledRoad(const int32 ChainIndex)
+	{
+		const TSharedPtr<PCGExClusters::FNodeChain>& Chain = ProcessedChains[ChainIndex];
+		const bool bReverse = ChainReversed[ChainIndex];
+
+		FZGRoad* Road = new(Roads.GetData() + ChainIndex) FZGRoad(this, Chain.Get(), bReverse);
+		if (IsRoamingLoop(ChainIndex)) { return; }
+
+		int32 StartNode = Chain->Seed.Node;
+		int32 EndNode = Chain->Links.Last().Node;
+		if (bReverse) { Swap(StartNode, EndNode); }
+
+		// Leaves never get a slot
+		Road->StartPolygon = PolygonSlots[StartNode];
+		Road->EndPolygon = PolygonSlots[EndNode];
+	}
+
+	void FProcessor::FinalizeShapes()
+	{
+		PolygonSlots.Empty();
+		TileStarts.Empty();
+		TileNodes.Empty();
+		TilePolygonStarts.Empty();
+		TilePolygonKeys.Empty();
+
+		AssignShapeIds();
+
+		// Reserve each shape's range in the shared staging buffer, polygons first then road windows.
+		// Roads never grow past their chain node count, polygons hold one point per connection.
+		int32 NumPolygonPoints = 0;
+		for (FZGPolygon& Polygon : Polygons)
+		{
+			Polygon.PointOffset = NumPolygonPoints;
+			Polygon.PointCapacity = Polygon.NumConnections;
+			NumPolygonPoints += Polygon.PointCapacity;
+		}
+
+		for (FZGRoad& Road : Roads)
+		{
+			Road.PointCapacity = Road.Chain->Links.Num() + 1;
+			MaxRoadPointCapacity = FMath::Max(MaxRoadPointCapacity, Road.PointCapacity);
+		}
+
+		SetStagingSize(BuildRoadWindows(NumPolygonPoints));
+
+		// Precompute all geometry off main thread, one scoped parallel loop per phase.
+		// Each phase only starts once the previous one has fully completed.
+		StartLaneProfilePhase();
+	}
+
+	void FProcessor::AssignShapeIds()
+	{
+		// Writers output every shape, dirty regions only apply to reused components
+		if (Context->BakeWriter || Context->StorageWriter)
+		{
+			for (FZGRoad& Road : Roads) { Road.bDirty = true; }
+			for (FZGPolygon& Polygon : Polygons) { Polygon.bDirty = true; }
+		}
+
+		// Stable identities derived from the source points, so regenerations can find their previous components and baked shapes keep theirs
+		auto MakeShapeId = [&](const uint64 Kind, const int32 A, const int32 B)
+		{
+			const uint64 Key[4] = {ShapeIdSeed, Kind, static_cast<uint32>(A), static_cast<uint32>(B)};
+			return FXxHash64::HashBuffer(Key, sizeof(Key)).Hash;
+		};
+
+		for (FZGRoad& Road : Roads) { Road.ShapeId = MakeShapeId(1, Cluster->GetNode(Road.Chain->Seed.Node)->PointIndex, Cluster->GetEdge(Road.Chain->Seed.Edge)->PointIndex); }
+		for (FZGPolygon& Polygon : Polygons) { Polygon.ShapeId = MakeShapeId(2, Cluster->GetNode(Polygon.NodeIndex)->PointIndex, -1); }
+
+		// Colliding identities can't tell their previous components apart, those shapes go without one and are always rebuilt
+		TSet<uint64> Seen;
+		TSet<uint64> Collisions;
+		Seen.Reserve(Roads.Num() + Polygons.Num());
+
+		auto Track = [&](const uint64 ShapeId)
+		{
+			bool bAlreadySeen = false;
+			Seen.Add(ShapeId, &bAlreadySeen);
+			if (bAlreadySeen) { Collisions.Add(ShapeId); }
+		};
+
+		for (const FZGRoad& Road : Roads) { Track(Road.ShapeId); }
+		for (const FZGPolygon& Polygon : Polygons) { Track(Polygon.ShapeId); }
+
+		if (!Collisions.IsEmpty())
+		{
+			for (FZGRoad& Road : Roads) { if (Collisions.Contains(Road.ShapeId)) { Road.ShapeId = 0; } }
+			for (FZGPolygon& Polygon : Polygons) { if (Collisions.Contains(Polygon.ShapeId)) { Polygon.ShapeId = 0; } }
+		}
+
+		if (bReuseComponents && !Context->DirtyBounds.IsEmpty()) { MarkDirtyShapes(); }
+	}
+
+	void FProcessor::MarkDirtyShapes()
+	{
+		// Roads touching a dirty region are rebuilt along with the polygons at their ends,
+		// then every road plugged into a rebuilt polygon follows since its trimmed endpoint may move.
+		for (FZGRoad& Road : Roads) { Road.bDirty = ChainTouchesDirtyBounds(*Road.Chain); }
+		for (FZGPolygon& Polygon : Polygons) { Polygon.bDirty = false; }
+
+		for (const FZGRoad& Road : Roads)
+		{
+			if (!Road.bDirty) { continue; }
+			if (Road.StartPolygon != -1) { Polygons[Road.StartPolygon].bDirty = true; }
+			if (Road.EndPolygon != -1) { Polygons[Road.EndPolygon].bDirty = true; }
+		}
+
+		for (FZGPolygon& Polygon : Polygons)
+		{
+			if (Polygon.bDirty)
+			{
+				for (const FZGConnection& Connection : Polygon.GetConnections()) { Roads[Connection.Road].bDirty = true; }
+			}
+			else if (!Context->HasReusableShape(Polygon.ShapeId))
+			{
+				// Nothing to keep, the shape has to be built regardless
+				Polygon.bDirty = true;
+			}
+		}
+
+		for (FZGRoad& Road : Roads)
+		{
+			if (!Road.bDirty && !Context->HasReusableShape(Road.ShapeId)) { Road.bDirty = true; }
+		}
+	}
+
+	bool FProcessor::ChainTouchesDirtyBounds(const PCGExClusters::FNodeChain& Chain) const
+	{
+		const TArray<FBox>& DirtyBounds = Context->DirtyBounds;
+
+		auto TouchesSegment = [&](const FVector& A, const FVector& B)
+		{
+			for (const FBox& Box : DirtyBounds)
+			{
+				if (Box.IsInsideOrOn(A) || Box.IsInsideOrOn(B)) { return true; }
+				if (FMath::LineBoxIntersection(Box, A, B, B - A)) { return true; }
+			}
+			return false;
+		};
+
+		FVector Prev = Cluster->GetPos(Chain.Seed.Node);
+		for (const PCGExClusters::FLink& Link : Chain.Links)
+		{
+			const FVector Next = Cluster->GetPos(Link.Node);
+			if (TouchesSegment(Prev, Next)) { return true; }
+			Prev = Next;
+		}
+
+		return false;
+	}
+
+	int32 FProcessor::BuildRoadWindows(const int32 FirstRoadPoint)
+	{
+		WindowStarts.Reset();
+		WindowStarts.Add(0);
+
+		if (!bStreaming)
+		{
+			int32 NumStagedPoints = FirstRoadPoint;
+			for (FZGRoad& Road : Roads)
+			{
+				Road.PointOffset = NumStagedPoints;
+				NumStagedPoints += Road.PointCapacity;
+			}
+
+			WindowStarts.Add(Roads.Num());
+			return NumStagedPoints;
+		}
+
+		// Windows follow a Morton order of road seed positions, so each one covers a compact area
+		FBox Bounds(ForceInit);
+		for (const FZGRoad& Road : Roads) { Bounds += Cluster->GetPos(Road.Chain->Seed.Node); }
+
+		const FVector Extent = Bounds.GetSize();
+		const FVector Scale(
+			Extent.X > UE_SMALL_NUMBER ? 1023 / Extent.X : 0,
+			Extent.Y > UE_SMALL_NUMBER ? 1023 / Extent.Y : 0,
+			Extent.Z > UE_SMALL_NUMBER ? 1023 / Extent.Z : 0);
+
+		TArray<TPair<uint32, int32>> Keys;
+		Keys.SetNumUninitialized(Roads.Num());
+		for (int32 i = 0; i < Roads.Num(); i++)
+		{
+			const FVector Cell = (Cluster->GetPos(Roads[i].Chain->Seed.Node) - Bounds.Min) * Scale;
+			Keys[i] = TPair<uint32, int32>(Kernels::MortonCode(Cell), i);
+		}
+
+		Keys.Sort([](const TPair<uint32, int32>& A, const TPair<uint32, int32>& B) { return A.Key < B.Key || (A.Key == B.Key && A.Value < B.Value); });
+
+		RoadOrder.SetNumUninitialized(Roads.Num());
+		for (int32 i = 0; i < Roads.Num(); i++) { RoadOrder[i] = Keys[i].Value; }
+
+		// The ceiling covers staged points only, polygons and the window range. A window always holds at least one road
+		constexpr int64 BytesPerPoint = sizeof(FVector) * 2 + sizeof(FRotator) + sizeof(float) + sizeof(FZoneShapePointType);
+		const int64 CeilingPoints = static_cast<int64>(Settings->StreamMemoryCeilingMb * 1024 * 1024) / BytesPerPoint;
+		const int64 MaxWindowPoints = FMath::Max<int64>(1, CeilingPoints - FirstRoadPoint);
+		const int32 MaxWindowRoads = FMath::Max(1, Settings->StreamWindowSize);
+
+		int32 WindowPoints = 0;
+		int32 WindowRoads = 0;
+		int32 MaxPoints = 0;
+
+		for (int32 i = 0; i < RoadOrder.Num(); i++)
+		{
+			FZGRoad& Road = Roads[RoadOrder[i]];
+			if (WindowRoads > 0 && (WindowRoads >= MaxWindowRoads || WindowPoints + Road.PointCapacity > MaxWindowPoints))
+			{
+				WindowStarts.Add(i);
+				WindowPoints = 0;
+				WindowRoads = 0;
+			}
+
+			Road.PointOffset = FirstRoadPoint + WindowPoints;
+			WindowPoints += Road.PointCapacity;
+			WindowRoads++;
+			MaxPoints = FMath::Max(MaxPoints, WindowPoints);
+		}
+
+		WindowStarts.Add(RoadOrder.Num());
+		return FirstRoadPoint + MaxPoints;
+	}
+
+	void FProcessor::StartLaneProfilePhase()
+	{
+		// Phase 1: Resolve lane profiles + cache widths (needed by auto-radius)
+		// Roads only write to themselves.
+		if (Roads.IsEmpty())
+		{
+			StartPolygonPrecomputePhase();
+			return;
+		}
+
+		PCGEX_ASYNC_GROUP_CHKD_VOID(TaskManager, ResolveLaneProfiles)
+
+		ResolveLaneProfiles->OnCompleteCallback =
+			[PCGEX_ASYNC_THIS_CAPTURE]()
+			{
+				PCGEX_ASYNC_THIS
+				This->StartPolygonPrecomputePhase();
+			};
+
+		ResolveLaneProfiles->OnSubLoopStartCallback =
+			[PCGEX_ASYNC_THIS_CAPTURE](const PCGExMT::FScope& Scope)
+			{
+				PCGEX_ASYNC_THIS
+				FPrecomputeScratch Scratch;
+				PCGEX_SCOPE_LOOP(Index) { This->Roads[Index].ResolveLaneProfile(This->Cluster, Scratch); }
+			};
+
+		ResolveLaneProfiles->StartSubLoops(Roads.Num(), GetDefault<UPCGExGlobalSettings>()->GetClusterBatchChunkSize());
+	}
+
+	void FProcessor::StartPolygonPrecomputePhase()
+	{
+		// Phase 2: Polygon precompute (uses road widths for auto-radius)
+		// Polygons write into their roads' endpoint slots; see FZGRoad::FPolygonEndpoint for ownership rules.
+		if (Polygons.IsEmpty())
+		{
+			StartRoadPrecomputePhase();
+			return;
+		}
+
+		PCGEX_ASYNC_GROUP_CHKD_VOID(TaskManager, PolygonPrecompute)
+
+		PolygonPrecompute->OnCompleteCallback =
+			[PCGEX_ASYNC_THIS_CAPTURE]()
+			{
+				PCGEX_ASYNC_THIS
+				This->StartRadiusSyncPhase();
+			};
+
+		PolygonPrecompute->OnSubLoopStartCallback =
+			[PCGEX_ASYNC_THIS_CAPTURE](const PCGExMT::FScope& Scope)
+			{
+				PCGEX_ASYNC_THIS
+				PCGEX_SCOPE_LOOP(Index) { This->Polygons[Index].Precompute(This->Cluster); }
+			};
+
+		PolygonPrecompute->StartSubLoops(Polygons.Num(), GetDefault<UPCGExGlobalSettings>()->GetClusterBatchChunkSize());
+	}
+
+	void FProcessor::StartRadiusSyncPhase()
+	{
+		// Phase 3: Push final polygon radii back to road endpoints
+		PCGEX_ASYNC_GROUP_CHKD_VOID(TaskManager, RadiusSync)
+
+		RadiusSync->OnCompleteCallback =
+			[PCGEX_ASYNC_THIS_CAPTURE]()
+			{
+				PCGEX_ASYNC_THIS
+				This->StartRoadPrecomputePhase();
+			};
+
+		RadiusSync->OnSubLoopStartCallback =
+			[PCGEX_ASYNC_THIS_CAPTURE](const PCGExMT::FScope& Scope)
+			{
+				PCGEX_ASYNC_THIS
+				PCGEX_SCOPE_LOOP(Index) { This->Polygons[Index].SyncRadiusToRoads(); }
+			};
+
+		RadiusSync->StartSubLoops(Polygons.Num(), GetDefault<UPCGExGlobalSettings>()->GetClusterBatchChunkSize());
+	}
+
+	void FProcessor::StartRoadPrecomputePhase()
+	{
+		// Phase 4: Road precompute (uses synced radii for endpoint offsets), one window at a time
+		const int32 WindowStart = WindowStarts[CurrentWindow];
+		const int32 NumWindowRoads = WindowStarts[CurrentWindow + 1] - WindowStart;
+
+		if (NumWindowRoads == 0)
+		{
+			OnRoadWindowReady();
+			return;
+		}
+
+		if (CurrentWindow == 0) { SelectRoadKernels(); }
+
+		PCGEX_ASYNC_GROUP_CHKD_VOID(TaskManager, RoadPrecompute)
+
+		RoadPrecompute->OnCompleteCallback =
+			[PCGEX_ASYNC_THIS_CAPTURE]()
+			{
+				PCGEX_ASYNC_THIS
+				This->OnRoadWindowReady();
+			};
+
+		RoadPrecompute->OnSubLoopStartCallback =
+			[PCGEX_ASYNC_THIS_CAPTURE](const PCGExMT::FScope& Scope)
+			{
+				PCGEX_ASYNC_THIS
+				TRACE_CPUPROFILER_EVENT_SCOPE(PCGExClusterToZoneGraph::RoadPrecompute);
+
+				FPrecomputeScratch Scratch;
+				Scratch.Nodes.Reserve(This->MaxRoadPointCapacity + 1);
+				Scratch.Directions.Reserve(This->MaxRoadPointCapacity);
+				const int32 WindowStart = This->WindowStarts[This->CurrentWindow];
+				PCGEX_SCOPE_LOOP(Index)
+				{
+					// Clean roads keep their previous component, their geometry isn't needed
+					FZGRoad& Road = This->Roads[This->GetRoadAt(WindowStart + Index)];
+					if (Road.bDirty) { Road.Precompute(This->Cluster, Scratch); }
+				}
+			};
+
+		RoadPrecompute->StartSubLoops(NumWindowRoads, GetDefault<UPCGExGlobalSettings>()->GetClusterBatchChunkSize());
+	}
+
+	void FProcessor::OnRoadWindowReady()
+	{
+		// The ready range is published before the in-flight flag drops, the scheduler reads it past that flag
+		CompileEnd = Polygons.Num() + WindowStarts[CurrentWindow + 1];
+
+		if (CurrentWindow == 0)
+		{
+			OnPrecomputeComplete();
+			return;
+		}
+
+		bWindowInFlight = false;
+		Context->CompileScheduler->Wake(TaskManager);
+	}
+
+	void FProcessor::StartNextWindow()
+	{
+		// The previous window is fully compiled, its staging range is overwritten by the next one
+		if (bWindowInFlight) { return; }
+
+		bWindowInFlight = true;
+		CurrentWindow++;
+		StartRoadPrecomputePhase();
+	}
+
+	void FProcessor::SetStagingSize(const int32 InNum)
+	{
+		ShapePoints.SetNum(InNum);
+		UpdateStagingBytes();
+	}
 
-		TArray<int32> Order;
-		PCGExArrayHelpers::ArrayOfIndices(Order, Roads.Num());
-		Order.Sort(
-			[&](const int32 A, const int32 B)
-			{
-				const bool bSeedA = (NodeIndex == Roads[A]->Chain->Seed.Node);
-				const bool bEndA = (NodeIndex == Roads[A]->Chain->Links.Last().Node);
-				const FVector DirA = Roads[A]->Chain->GetEdgeDir(Cluster, (bSeedA && bEndA) ? FromStart[A] : bSeedA);
+	void FProcessor::ReleaseStaging()
+	{
+		ShapePoints.Empty();
+		UpdateStagingBytes();
+	}
 
-				const bool bSeedB = (NodeIndex == Roads[B]->Chain->Seed.Node);
-				const bool bEndB = (NodeIndex == Roads[B]->Chain->Links.Last().Node);
-				const FVector DirB = Roads[B]->Chain->GetEdgeDir(Cluster, (bSeedB && bEndB) ? FromStart[B] : bSeedB);
+	void FProcessor::UpdateStagingBytes()
+	{
+		const int64 Bytes = ShapePoints.GetAllocatedSize();
+		Context->TrackStagingBytes(Bytes - StagingBytes);
+		StagingBytes = Bytes;
+	}
 
-				return PCGExMath::GetRadiansBetweenVectors(DirA, FVector::ForwardVector) > PCGExMath::GetRadiansBetweenVectors(DirB, FVector::ForwardVector);
-			});
+	uint64 FProcessor::ComputePrecomputeKey() const
+	{
+		// Topology, positions, breakpoints and every attribute shapes read, on top of the context-wide settings hash
+		FXxHash64Builder Builder;
+		Builder.Update(&Context->PrecomputeSettingsHash, sizeof(uint64));
+		Builder.Update(&NumNodes, sizeof(int32));
+		Builder.Update(&NumEdges, sizeof(int32));
 
-		PCGExArrayHelpers::InitArray(PrecomputedPoints, Order.Num());
-		CachedPointLaneProfiles.SetNum(Order.Num());
-		CachedPointHalfWidths.SetNum(Order.Num());
+		for (int32 i = 0; i < NumNodes; i++)
+		{
+			const int32 PointIndex = Cluster->GetNode(i)->PointIndex;
+			const FVector Position = Cluster->GetPos(i);
+			Builder.Update(&PointIndex, sizeof(int32));
+			Builder.Update(&Position, sizeof(FVector));
+		}
 
-		for (int i = 0; i < Order.Num(); i++)
+		for (int32 i = 0; i < NumEdges; i++)
 		{
-			const int32 Ri = Order[i];
-			const TSharedPtr<FZGRoad>& Road = Roads[Ri];
-			const bool bAtChainSeed = (NodeIndex == Road->Chain->Seed.Node);
-			const bool bAtChainEnd = (NodeIndex == Road->Chain->Links.Last().Node);
+			const auto* Edge = Cluster->GetEdge(i);
+			const uint32 EdgeData[3] = {Edge->Start, Edge->End, static_cast<uint32>(Edge->PointIndex)};
+			Builder.Update(EdgeData, sizeof(EdgeData));
 
-			// For lollipop chains (single breakpoint on closed loop), seed==end node.
-			// Use FromStart to disambiguate: start connection → first edge dir, end connection → last edge dir.
-			const FVector RoadDirection = Road->Chain->GetEdgeDir(Cluster, (bAtChainSeed && bAtChainEnd) ? FromStart[Ri] : bAtChainSeed);
+			if (EdgeLaneProfileBuffer)
+			{
+				const uint32 ProfileHash = GetTypeHash(EdgeLaneProfileBuffer->Read(Edge->PointIndex));
+				Builder.Update(&ProfileHash, sizeof(uint32));
+			}
+		}
 
-			// Store polygon boundary data on the road for precise intersection
-			FZGRoad::FPolygonEndpoint EP;
-			EP.PolygonCenter = CenterPosition;
-			EP.Direction = RoadDirection;
-			EP.Radius = CachedRoadRadii[Ri];
-			EP.bValid = true;
+		if (VtxFilterCache) { Builder.Update(VtxFilterCache->GetData(), VtxFilterCache->Num() * VtxFilterCache->GetTypeSize()); }
 
-			if (FromStart[Ri]) { Road->StartEndpoint = EP; }
-			else { Road->EndEndpoint = EP; }
+		auto HashVtxValues = [&](const auto& Source)
+		{
+			if (!Source) { return; }
+			for (int32 i = 0; i < NumNodes; i++)
+			{
+				const auto Value = Source->Read(Cluster->GetNode(i)->PointIndex);
+				Builder.Update(&Value, sizeof(Value));
+			}
+		};
 
-			FZoneShapePoint ShapePoint = FZoneShapePoint(CenterPosition + RoadDirection * CachedRoadRadii[Ri]);
-			ShapePoint.SetRotationFromForwardAndUp(RoadDirection * -1, FVector::UpVector);
-			ShapePoint.Type = CachedPointType;
+		HashVtxValues(PolygonRadiusBuffer);
+		HashVtxValues(PolygonRoutingTypeBuffer);
+		HashVtxValues(PolygonPointTypeBuffer);
+		HashVtxValues(RoadPointTypeBuffer);
+		HashVtxValues(AdditionalIntersectionTagsBuffer);
+		HashVtxValues(TangentLengthGetter);
 
-			PrecomputedPoints[i] = ShapePoint;
-			CachedPointLaneProfiles[i] = Road->CachedLaneProfile;
-			CachedPointHalfWidths[i] = Road->CachedTotalProfileWidth * 0.5;
-		}
+		return Builder.Finalize().Hash;
 	}
 
-	void FZGPolygon::SyncRadiusToRoads()
+	FPrecomputeRoute RoutePrecompute(const bool bCachePrecompute, const bool bRestored, const bool bComplete, const bool bBake, const bool bStorage)
 	{
-		for (int32 i = 0; i < Roads.Num(); i++)
+		// Clean shapes skip their precompute, so only complete clusters are cached, and restored ones are already
+		FPrecomputeRoute Route;
+		Route.bStore = bCachePrecompute && !bRestored && bComplete;
+		Route.Output = bBake ? EPrecomputeOutput::Bake : bStorage ? EPrecomputeOutput::Storage : EPrecomputeOutput::Compile;
+		return Route;
+	}
+
+	EClaimFallback ResolveClaimFallback(const bool bRestored, const bool bKernelsSelected)
+	{
+		// Restored clusters were cached complete, so every road holds its staged points even when clean
+		if (bRestored) { return EClaimFallback::UseStaged; }
+		return bKernelsSelected ? EClaimFallback::Precompute : EClaimFallback::SelectKernels;
+	}
+
+	bool FProcessor::TryRestorePrecompute()
+	{
+		const TSharedPtr<const FPrecomputedShapes> Cached = FPrecomputeCache::Get().Find(PrecomputeKey);
+		if (!Cached)
 		{
-			if (FromStart[i])
-			{
-				Roads[i]->StartRadius = CachedRoadRadii[i];
-			}
-			else
-			{
-				Roads[i]->EndRadius = CachedRoadRadii[i];
-			}
+			Context->NumPrecomputeMisses.Increment();
+			return false;
 		}
+
+		Context->NumPrecomputeHits.Increment();
+
+		// Chains are shared with the cache and never modified past their construction
+		ProcessedChains = Cached->Chains;
+		Roads = Cached->Roads;
+		Polygons = Cached->Polygons;
+		Connections = Cached->Connections;
+		ShapePoints = Cached->ShapePoints;
+		UpdateStagingBytes();
+
+		for (FZGRoad& Road : Roads) { Road.SetProcessor(this); }
+		for (FZGPolygon& Polygon : Polygons) { Polygon.SetProcessor(this); }
+
+		bPrecomputeRestored = true;
+		return true;
 	}
 
-	void FZGPolygon::BuildPathOutput(const TSharedPtr<PCGExData::FPointIO>& InPathIO) const
+	void FProcessor::StorePrecompute()
 	{
-		const TArrayView<const FZoneShapePoint> Points = Component->GetPoints();
-		const int32 NumConnections = Points.Num();
-		PCGExPointArrayDataHelpers::SetNumPointsAllocated(InPathIO->GetOut(), NumConnections * 2);
+		const TSharedPtr<FPrecomputedShapes> Shapes = MakeShared<FPrecomputedShapes>();
+		Shapes->Chains = ProcessedChains;
+		Shapes->Roads = Roads;
+		Shapes->Polygons = Polygons;
+		Shapes->Connections = Connections;
+		Shapes->ShapePoints = ShapePoints;
+
+		FPrecomputeCache::Get().Add(PrecomputeKey, Shapes, GetCacheMaxSize(CVarPrecomputeCacheMaxMB));
+	}
 
-		TPCGValueRange<FTransform> Transforms = InPathIO->GetOut()->GetTransformValueRange();
-		for (int32 i = 0; i < NumConnections; i++)
-		{
-			const FZoneShapePoint& Pt = Points[i];
-			const double HalfWidth = Pt.TangentLength;
+	void FProcessor::OnPrecomputeComplete()
+	{
+		const bool bComplete = !Roads.ContainsByPredicate([](const FZGRoad& Road) { return !Road.bDirty; });
+		const FPrecomputeRoute Route = RoutePrecompute(bCachePrecompute, bPrecomputeRestored, bComplete, Context->BakeWriter.IsValid(), Context->StorageWriter.IsValid());
 
-			const FVector Left = Pt.Position + Pt.Rotation.RotateVector(FVector::LeftVector) * HalfWidth;
-			const FVector Right = Pt.Position + Pt.Rotation.RotateVector(FVector::RightVector) * HalfWidth;
+		if (Route.bStore) { StorePrecompute(); }
 
-			Transforms[i * 2] = FTransform(Pt.Rotation, Right);
-			Transforms[i * 2 + 1] = FTransform(Pt.Rotation, Left);
+		switch (Route.Output)
+		{
+		case EPrecomputeOutput::Bake:
+			BakeShapes();
+			break;
+		case EPrecomputeOutput::Storage:
+			EmitStorage();
+			break;
+		default:
+			StartCompileLoop();
+			break;
 		}
 	}
 
-	void FZGPolygon::Compile()
+	void FProcessor::BakeShapes()
 	{
-		Component->SetShapeType(FZoneShapeType::Polygon);
-		Component->SetPolygonRoutingType(CachedRoutingType);
-		Component->SetTags(Component->GetTags() | CachedAdditionalTags);
-		Component->SetCommonLaneProfile(CachedLaneProfile);
+		// Baked shapes are materialized off the game thread, in the same order components would be compiled
+		PCGExZoneShapeBake::FChunk Chunk;
+		Chunk.SortKey = (static_cast<uint64>(VtxDataFacade->Source->IOIndex) << 32) | static_cast<uint32>(EdgeDataFacade->Source->IOIndex);
 
-		// Register per-point lane profiles so each polygon connection uses its road's profile
-		for (int32 i = 0; i < PrecomputedPoints.Num(); i++)
+		TArray<FZoneShapePoint> Scratch;
+		for (const FZGPolygon& Polygon : Polygons) { Polygon.Bake(Chunk, Scratch); }
+		for (const FZGRoad& Road : Roads)
 		{
-			const int32 ProfileIdx = Component->AddUniquePerPointLaneProfile(CachedPointLaneProfiles[i]);
-			PrecomputedPoints[i].LaneProfile = static_cast<uint8>(ProfileIdx);
+			if (!Road.bDegenerate) { Road.Bake(Chunk, Scratch); }
 		}
 
-		Component->GetMutablePoints() = MoveTemp(PrecomputedPoints);
-		Component->UpdateShape();
+		ReleaseStaging();
+		Context->BakeWriter->AddChunk(MoveTemp(Chunk));
 	}
 
-	bool FProcessor::Process(const TSharedPtr<PCGExMT::FTaskManager>& InTaskManager)
+	void FProcessor::EmitStorage()
 	{
-		TRACE_CPUPROFILER_EVENT_SCOPE(PCGExClusterToZoneGraph::Process);
-
-		if (!IProcessor::Process(InTaskManager)) { return false; }
-
-		if (!DirectionSettings.InitFromParent(ExecutionContext, GetParentBatch<FBatch>()->DirectionSettings, EdgeDataFacade)) { return false; }
+		// Lanes are tessellated off the game thread, polygons first so roads can link into their zones
+		PCGExZoneGraphStorage::FChunk Chunk;
+		Chunk.SortKey = (static_cast<uint64>(VtxDataFacade->Source->IOIndex) << 32) | static_cast<uint32>(EdgeDataFacade->Source->IOIndex);
 
-		if (Settings->bOverridePolygonRadius) { PolygonRadiusBuffer = VtxDataFacade->GetBroadcaster<double>(Settings->PolygonRadiusAttribute); }
-		if (Settings->bOverridePolygonRoutingType) { PolygonRoutingTypeBuffer = VtxDataFacade->GetBroadcaster<int32>(Settings->PolygonRoutingTypeAttribute); }
-		if (Settings->bOverridePolygonPointType) { PolygonPointTypeBuffer = VtxDataFacade->GetBroadcaster<int32>(Settings->PolygonPointTypeAttribute); }
-		if (Settings->bOverrideRoadPointType) { RoadPointTypeBuffer = VtxDataFacade->GetBroadcaster<int32>(Settings->RoadPointTypeAttribute); }
-		if (Settings->bOverrideAdditionalIntersectionTags) { AdditionalIntersectionTagsBuffer = VtxDataFacade->GetBroadcaster<int32>(Settings->AdditionalIntersectionTagsAttribute); }
-		if (Settings->bOverrideLaneProfile) { EdgeLaneProfileBuffer = EdgeDataFacade->GetBroadcaster<FName>(Settings->LaneProfileAttribute); }
+		TArray<FZoneShapePoint> Scratch;
+		TArray<FZoneLaneProfile> ProfileScratch;
 
-		if (Settings->RoadTangentLengthMode == EPCGExZGTangentLengthMode::Manual)
-		{
-			TangentLengthGetter = Settings->TangentLength.GetValueSetting();
-			if (!TangentLengthGetter->Init(VtxDataFacade, false)) { return false; }
-		}
+		TArray<int32> PolygonZones;
+		PolygonZones.SetNumUninitialized(Polygons.Num());
+		for (int32 i = 0; i < Polygons.Num(); i++) { PolygonZones[i] = Polygons[i].Emit(Chunk, Scratch, ProfileScratch); }
 
-		if (VtxFiltersManager)
+		for (const FZGRoad& Road : Roads)
 		{
-			PCGEX_ASYNC_GROUP_CHKD(TaskManager, FilterBreakpoints)
-
-			FilterBreakpoints->OnCompleteCallback =
-				[PCGEX_ASYNC_THIS_CAPTURE]()
-				{
-					PCGEX_ASYNC_THIS
-					This->BuildChains();
-				};
+			if (Road.bDegenerate) { continue; }
 
-			FilterBreakpoints->OnSubLoopStartCallback =
-				[PCGEX_ASYNC_THIS_CAPTURE](const PCGExMT::FScope& Scope)
-				{
-					PCGEX_ASYNC_THIS
-					This->FilterVtxScope(Scope);
-				};
+			const int32 RoadZone = Road.Emit(Chunk, Scratch);
+			if (RoadZone == -1) { continue; }
 
-			FilterBreakpoints->StartSubLoops(NumNodes, GetDefault<UPCGExGlobalSettings>()->GetClusterBatchChunkSize());
-		}
-		else
-		{
-			return BuildChains();
+			for (const int32 Polygon : {Road.StartPolygon, Road.EndPolygon})
+			{
+				if (Polygon != -1 && PolygonZones[Polygon] != -1) { Chunk.ConnectZones(RoadZone, PolygonZones[Polygon]); }
+			}
 		}
 
-		return true;
+		ReleaseStaging();
+		Context->StorageWriter->AddChunk(MoveTemp(Chunk));
 	}
 
-	bool FProcessor::BuildChains()
+	void FProcessor::StartCompileLoop()
 	{
-		bIsProcessorValid = PCGExClusters::ChainHelpers::GetOrBuildChains(
-			Cluster.ToSharedRef(),
-			ProcessedChains,
-			VtxFilterCache,
-			false);
-
-		if (!bIsProcessorValid) { return false; }
-
-		Polygons.Reserve(NumNodes / 2);
+		if (Polygons.IsEmpty() && Roads.IsEmpty()) { return; }
 
-		return bIsProcessorValid;
+		CachedAttachmentRules = Settings->AttachmentRules.GetRules();
+		Context->CompileScheduler->Enqueue(SharedThis(this), TaskManager);
 	}
 
-	void FProcessor::CompleteWork()
+	bool FProcessor::PrepareCompile()
 	{
-		if (ProcessedChains.IsEmpty())
+		if (bCompilePrepared) { return TargetActor != nullptr; }
+		bCompilePrepared = true;
+
+		// Resolve TargetActor lazily when first scheduled (runs on main thread)
+		TargetActor = ExecutionContext->GetTargetActor(nullptr);
+		if (!TargetActor)
 		{
+			PCGE_LOG_C(Error, GraphAndLog, ExecutionContext, FTEXT("Invalid target actor."));
 			bIsProcessorValid = false;
-			return;
+			return false;
 		}
 
-		TMap<int32, TSharedPtr<FZGPolygon>> Map;
+		CachedObjectFlags = Context->GetComponent()->IsInPreviewMode() ? RF_Transient : RF_NoFlags;
 
-		const int32 NumChains = ProcessedChains.Num();
+		return true;
+	}
 
-		Roads.Reserve(NumChains);
+	int32 FProcessor::CompileShapes(const int32 Count)
+	{
+		// Batches never mix polygons and roads, so cost estimates stay per shape kind.
+		// Components are created and compiled for the whole batch, then attached in a single pass.
+		const int32 NumPolygons = Polygons.Num();
+		const int32 Start = CompileCursor;
+		const int32 End = FMath::Min(Start + Count, Start < NumPolygons ? NumPolygons : CompileEnd);
+		CompileCursor = End;
 
-		TArray<bool> DFSReversed;
-		if (Settings->OrientationMode == EPCGExZGOrientationMode::DepthFirst) { ComputeDFSOrientation(DFSReversed); }
+		CompileBatch.Reset();
+		int32 NumCompiled = 0;
+		FPrecomputeScratch FallbackScratch;
 
-		for (int i = 0; i < NumChains; i++)
+		auto CompileShape = [&](auto& Shape)
 		{
-			const TSharedPtr<PCGExClusters::FNodeChain>& Chain = ProcessedChains[i];
-			if (!Chain) { continue; }
-
-			int32 StartNode = Chain->Seed.Node;
-			int32 EndNode = Chain->Links.Last().Node;
-
-			bool bReverse;
-			switch (Settings->OrientationMode)
+			if (!Shape.bDirty)
 			{
-			case EPCGExZGOrientationMode::DepthFirst:
-				bReverse = DFSReversed[i] != Settings->bInvertOrientation;
-				if (bReverse) { Swap(StartNode, EndNode); }
-				break;
-
-			case EPCGExZGOrientationMode::GlobalDirection:
+				// Outside of the dirty regions, the previous component is kept as-is
+				if (Shape.KeepComponent(TargetActor))
 				{
-					const FVector RoadDir = (Cluster->GetPos(EndNode) - Cluster->GetPos(StartNode)).GetSafeNormal();
-					bReverse = (FVector::DotProduct(RoadDir, Settings->OrientationDirection) < 0) != Settings->bInvertOrientation;
-					if (bReverse) { Swap(StartNode, EndNode); }
+					Context->NumUnchangedShapes++;
+					return;
 				}
-				break;
-
-			default: // SortDirection
-				bReverse = DirectionSettings.SortExtrapolation(Cluster.Get(), Chain->Seed.Edge, StartNode, EndNode);
-				break;
-			}
 
-			TSharedPtr<FZGRoad> Road = MakeShared<FZGRoad>(this, Chain, bReverse);
-			Roads.Add(Road);
-
-			const PCGExClusters::FNode* Start = Cluster->GetNode(StartNode);
-			const PCGExClusters::FNode* End = Cluster->GetNode(EndNode);
+				// The claim failed (component moved to another actor or destroyed since boot), build the shape after all
+				Shape.bDirty = true;
+				if constexpr (std::is_same_v<std::decay_t<decltype(Shape)>, FZGRoad>)
+				{
+					// Clean roads skipped precompute, their staging range is still reserved
+					switch (ResolveClaimFallback(bPrecomputeRestored, RoadKernels[0] != nullptr))
+					{
+					case EClaimFallback::SelectKernels:
+						SelectRoadKernels();
+						Shape.Precompute(Cluster, FallbackScratch);
+						break;
+					case EClaimFallback::Precompute:
+						Shape.Precompute(Cluster, FallbackScratch);
+						break;
+					default:
+						break;
+					}
 
-			if (Chain->bIsClosedLoop && Start->IsBinary() && End->IsBinary())
-			{
-				// Roaming closed loop, road only!
-				continue;
+					if (Shape.bDegenerate) { return; }
+				}
 			}
 
-			if (!Start->IsLeaf())
+			if (bReuseComponents)
 			{
-				const TSharedPtr<FZGPolygon>* PolygonPtr = Map.Find(StartNode);
-
-				if (!PolygonPtr)
+				// Unchanged shapes keep their previous component untouched, changed ones are updated in place
+				bool bUnchanged = false;
+				if (Shape.TryReuseComponent(TargetActor, bUnchanged))
 				{
-					TSharedPtr<FZGPolygon> NewPolygon = MakeShared<FZGPolygon>(this, Start);
-					Polygons.Add(NewPolygon);
-					Map.Add(StartNode, NewPolygon);
-					PolygonPtr = &NewPolygon;
+					if (bUnchanged)
+					{
+						Context->NumUnchangedShapes++;
+						return;
+					}
+
+					Shape.Compile();
+					CommitShape(Shape, false);
+					Context->NumUpdatedShapes++;
+					NumCompiled++;
+					return;
 				}
-				(*PolygonPtr)->Add(Road, true);
 			}
 
-			if (!End->IsLeaf())
+			Shape.InitComponent(TargetActor);
+			if (!Shape.Component) { return; }
+			Shape.Compile();
+			CompileBatch.Add(&Shape);
+			NumCompiled++;
+		};
+
+		if (Start < NumPolygons)
+		{
+			for (int32 i = Start; i < End; i++) { CompileShape(Polygons[i]); }
+		}
+		else
+		{
+			for (int32 i = Start - NumPolygons; i < End - NumPolygons; i++)
 			{
-				const TSharedPtr<FZGPolygon>* PolygonPtr = Map.Find(EndNode);
+				FZGRoad& Road = Roads[GetRoadAt(i)];
+				if (!Road.bDegenerate) { CompileShape(Road); }
+			}
+		}
 
-				if (!PolygonPtr)
-				{
-					TSharedPtr<FZGPolygon> NewPolygon = MakeShared<FZGPolygon>(this, End);
-					Polygons.Add(NewPolygon);
-					Map.Add(EndNode, NewPolygon);
-					PolygonPtr = &NewPolygon;
-				}
+		for (const FZGBase* Shape : CompileBatch) { CommitShape(*Shape, true); }
 
-				(*PolygonPtr)->Add(Road, false);
-			}
+		return NumCompiled;
+	}
+
+	void FProcessor::CommitShape(const FZGBase& Shape, const bool bAttach)
+	{
+#if WITH_EDITOR
+		if (Context->bHoldZoneGraphBuilds)
+		{
+			Context->HoldShape(TargetActor, Shape.Component, Shape.ManagedShape, CachedAttachmentRules, bAttach);
+			return;
 		}
+#endif
 
-		// Precompute all geometry off main thread
-		// Phase 1: Resolve lane profiles + cache widths (needed by auto-radius)
-		for (const TSharedPtr<FZGRoad>& Road : Roads) { Road->ResolveLaneProfile(Cluster); }
-		// Phase 2: Polygon precompute (uses road widths for auto-radius)
-		for (const TSharedPtr<FZGPolygon>& Polygon : Polygons) { Polygon->Precompute(Cluster); }
-		// Phase 3: Push final polygon radii back to road endpoints
-		for (const TSharedPtr<FZGPolygon>& Polygon : Polygons) { Polygon->SyncRadiusToRoads(); }
-		// Phase 4: Road precompute (uses synced radii for endpoint offsets)
-		for (const TSharedPtr<FZGRoad>& Road : Roads) { Road->Precompute(Cluster); }
+		Shape.Component->UpdateShape();
+		if (bAttach) { Context->AttachShapeComponent(TargetActor, Shape.Component, Shape.ManagedShape, CachedAttachmentRules); }
+	}
 
-		const int32 NumPolygons = Polygons.Num();
-		const int32 TotalCount = NumPolygons + Roads.Num();
+	void FProcessor::OnCompileComplete()
+	{
+		ReleaseStaging();
+		CompileBatch.Empty();
+		if (!TargetActor) { return; }
 
-		if (TotalCount == 0) { return; }
+		Context->AddNotifyActor(TargetActor);
+		StartPathOutputPhase();
+	}
 
-		CachedAttachmentRules = Settings->AttachmentRules.GetRules();
+	void FProcessor::StartPathOutputPhase()
+	{
+		// Path outputs only read back compiled components, so they're built off the game thread.
+		if (!Context->OutputPolygonPaths && !Context->OutputRoadPaths) { return; }
 
+		// One slot per shape, appended in shape order before the parallel fill so the output order doesn't depend on scheduling.
+		// Polygons are keyed by their node, roads by their seed edge, which is unique even when roads share a seed node.
 		const int32 IOBase = (VtxDataFacade->Source->IOIndex + 1) * 100000;
+		const int32 NumPolygons = Polygons.Num();
+		PathSlots.Init(nullptr, NumPolygons + Roads.Num());
 
-		// Create the time-sliced main-thread loop and register it as a handle.
-		// The registered handle prevents the task manager from completing until
-		// all iterations finish. No separate token or deferred tick action needed.
-		MainCompileLoop = MakeShared<PCGExMT::FTimeSlicedMainThreadLoop>(TotalCount);
-		MainCompileLoop->OnIterationCallback = [PCGEX_ASYNC_THIS_CAPTURE, NumPolygons, IOBase](const int32 Index, const PCGExMT::FScope& Scope)
+		if (Context->OutputPolygonPaths)
 		{
-			PCGEX_ASYNC_THIS
+			for (int32 i = 0; i < NumPolygons; i++)
+			{
+				if (!Polygons[i].Component) { continue; }
+				PathSlots[i] = Context->OutputPolygonPaths->Emplace_GetRef(VtxDataFacade->Source, PCGExData::EIOInit::New);
+				PathSlots[i]->IOIndex = IOBase + Cluster->GetNode(Polygons[i].NodeIndex)->PointIndex;
+			}
+		}
 
-			// Resolve TargetActor lazily on first iteration (runs on main thread)
-			if (Index == 0)
+		if (Context->OutputRoadPaths)
+		{
+			for (int32 i = 0; i < Roads.Num(); i++)
 			{
-				This->TargetActor = This->ExecutionContext->GetTargetActor(nullptr);
-				if (!This->TargetActor)
-				{
-					PCGE_LOG_C(Error, GraphAndLog, This->ExecutionContext, FTEXT("Invalid target actor."));
-					This->bIsProcessorValid = false;
-				}
+				if (!Roads[i].Component) { continue; }
+				PathSlots[NumPolygons + i] = Context->OutputRoadPaths->Emplace_GetRef(VtxDataFacade->Source, PCGExData::EIOInit::New);
+				PathSlots[NumPolygons + i]->IOIndex = IOBase + Cluster->GetEdge(Roads[i].Chain->Seed.Edge)->PointIndex;
 			}
+		}
 
-			if (!This->TargetActor) { return; }
+		PCGEX_ASYNC_GROUP_CHKD_VOID(TaskManager, PathOutput)
 
-			if (Index < NumPolygons)
+		PathOutput->OnCompleteCallback =
+			[PCGEX_ASYNC_THIS_CAPTURE]()
 			{
-				auto& Polygon = This->Polygons[Index];
-				Polygon->InitComponent(This->TargetActor);
-				This->Context->AttachManagedComponent(This->TargetActor, Polygon->Component, This->CachedAttachmentRules);
-				Polygon->Compile();
+				PCGEX_ASYNC_THIS
+				This->PathSlots.Empty();
+			};
 
-				if (This->Context->OutputPolygonPaths)
-				{
-					const int32 PointIndex = This->Cluster->GetNode(Polygon->NodeIndex)->PointIndex;
-					TSharedPtr<PCGExData::FPointIO> PathIO = This->Context->OutputPolygonPaths->Emplace_GetRef(This->VtxDataFacade->Source, PCGExData::EIOInit::New);
-					PathIO->IOIndex = IOBase + PointIndex;
-					Polygon->BuildPathOutput(PathIO);
-					PCGExPaths::Helpers::SetClosedLoop(PathIO, true);
-				}
-			}
-			else
+		PathOutput->OnSubLoopStartCallback =
+			[PCGEX_ASYNC_THIS_CAPTURE](const PCGExMT::FScope& Scope)
 			{
-				const int32 RoadIndex = Index - NumPolygons;
-				auto& Road = This->Roads[RoadIndex];
-				if (Road->bDegenerate) { return; }
-				Road->InitComponent(This->TargetActor);
-				This->Context->AttachManagedComponent(This->TargetActor, Road->Component, This->CachedAttachmentRules);
-				Road->Compile();
+				PCGEX_ASYNC_THIS
+				PCGEX_SCOPE_LOOP(Index) { This->BuildPathOutput(Index); }
+			};
 
-				if (This->Context->OutputRoadPaths)
-				{
-					TSharedPtr<PCGExData::FPointIO> PathIO = This->Context->OutputRoadPaths->Emplace_GetRef(This->VtxDataFacade->Source, PCGExData::EIOInit::New);
-					PathIO->IOIndex = IOBase + This->Cluster->GetNode(Road->Chain->Seed.Node)->PointIndex;
-					Road->BuildPathOutput(PathIO);
-				}
-			}
-		};
+		PathOutput->StartSubLoops(PathSlots.Num(), GetDefault<UPCGExGlobalSettings>()->GetClusterBatchChunkSize());
+	}
 
-		MainCompileLoop->OnCompleteCallback = [PCGEX_ASYNC_THIS_CAPTURE]()
-		{
-			PCGEX_ASYNC_THIS
-			if (This->TargetActor) { This->Context->AddNotifyActor(This->TargetActor); }
-		};
+	void FProcessor::BuildPathOutput(const int32 Index)
+	{
+		const TSharedPtr<PCGExData::FPointIO>& PathIO = PathSlots[Index];
+		if (!PathIO) { return; }
 
-		PCGEX_ASYNC_HANDLE_CHKD_VOID(TaskManager, MainCompileLoop)
+		const int32 NumPolygons = Polygons.Num();
+		if (Index < NumPolygons)
+		{
+			Polygons[Index].BuildPathOutput(PathIO);
+			PCGExPaths::Helpers::SetClosedLoop(PathIO, true);
+		}
+		else
+		{
+			Roads[Index - NumPolygons].BuildPathOutput(PathIO);
+		}
 	}
 
 	void FProcessor::ProcessRange(const PCGExMT::FScope& Scope)
@@ -943,14 +2990,13 @@ namespace PCGExClusterToZoneGraph
 
 	void FProcessor::Output()
 	{
-		// Component creation, attachment, and notify are handled in MainCompileLoop
+		// Component creation, attachment, and notify are handled by the context compile scheduler
 		// which runs on the main thread via the time-sliced loop mechanism.
 	}
 
-	void FProcessor::ComputeDFSOrientation(TArray<bool>& OutReversed) const
+	void FProcessor::BuildOrientationGraph()
 	{
 		const int32 NumChains = ProcessedChains.Num();
-		OutReversed.Init(false, NumChains);
 
 		// BFS to assign depths to polygon nodes, then orient chains from lower to higher depth.
 		// Leaf edges always flow toward the polygon (leaf is start, polygon is end).
@@ -958,110 +3004,171 @@ namespace PCGExClusterToZoneGraph
 		// the polygon and outgoing roads face away, giving the same global forward direction
 		// for through-traffic.
 
-		struct FAdj
+		// Adjacency between polygon (non-leaf) nodes is read from the connector table.
+		// Connectors are stored in chain order so BFS visits match a per-node list walk.
+
+		// Union-find over polygon nodes to label connected components
+		TArray<int32> Parent;
+		PCGExArrayHelpers::ArrayOfIndices(Parent, NumNodes);
+
+		auto FindRoot = [&](int32 Node)
 		{
-			int32 ChainIdx;
-			int32 OtherNode;
-			bool bIsSeed;
+			while (Parent[Node] != Node)
+			{
+				Parent[Node] = Parent[Parent[Node]];
+				Node = Parent[Node];
+			}
+			return Node;
 		};
 
-		TMap<int32, TArray<FAdj>> NodeAdj;
+		for (const FZGConnection& Connector : Connections)
+		{
+			if (Connector.Opposite == -1 || !Connector.bAtSeed) { continue; }
+
+			const int32 RootA = FindRoot(ProcessedChains[Connector.Road]->Seed.Node);
+			const int32 RootB = FindRoot(Connector.Opposite);
+			if (RootA != RootB) { Parent[FMath::Max(RootA, RootB)] = FMath::Min(RootA, RootB); }
+		}
+
+		// One BFS seed per component: the first polygon node met along the chains,
+		// which is the node a single serial BFS sweep would have started from.
+		TBitArray<> SeededRoots;
+		SeededRoots.Init(false, NumNodes);
 
 		for (int32 i = 0; i < NumChains; i++)
 		{
 			const auto& Chain = ProcessedChains[i];
-			if (!Chain) { continue; }
-
 			const int32 SN = Chain->Seed.Node;
 			const int32 EN = Chain->Links.Last().Node;
 
-			if (!Cluster->GetNode(SN)->IsLeaf()) { NodeAdj.FindOrAdd(SN).Add({i, EN, true}); }
-			if (!Cluster->GetNode(EN)->IsLeaf()) { NodeAdj.FindOrAdd(EN).Add({i, SN, false}); }
+			for (const int32 Node : {SN, EN})
+			{
+				if (Cluster->GetNode(Node)->IsLeaf()) { continue; }
+
+				const int32 Root = FindRoot(Node);
+				if (SeededRoots[Root]) { continue; }
+
+				SeededRoots[Root] = true;
+				ComponentSeeds.Add(Node);
+			}
 		}
 
-		// BFS to assign depths
-		TMap<int32, int32> NodeDepth;
-		TArray<int32> Queue;
+		NodeDepth.Init(-1, NumNodes);
+	}
+
+	void FProcessor::AssignComponentDepths(const int32 Seed, TArray<int32>& Queue)
+	{
+		Queue.Reset();
+
+		NodeDepth[Seed] = 0;
+		Queue.Add(Seed);
 
-		for (auto& [Node, _] : NodeAdj)
+		int32 Head = 0;
+		while (Head < Queue.Num())
 		{
-			if (NodeDepth.Contains(Node)) { continue; }
-			NodeDepth.Add(Node, 0);
-			Queue.Add(Node);
+			const int32 Current = Queue[Head++];
+			const int32 NextDepth = NodeDepth[Current] + 1;
 
-			int32 Head = Queue.Num() - 1;
-			while (Head < Queue.Num())
+			for (int32 c = ConnectorStart[Current]; c < ConnectorStart[Current + 1]; c++)
 			{
-				const int32 Current = Queue[Head++];
-				const int32 CurrDepth = NodeDepth[Current];
-
-				if (const TArray<FAdj>* Neighbors = NodeAdj.Find(Current))
-				{
-					for (const FAdj& A : *Neighbors)
-					{
-						if (!Cluster->GetNode(A.OtherNode)->IsLeaf() && !NodeDepth.Contains(A.OtherNode))
-						{
-							NodeDepth.Add(A.OtherNode, CurrDepth + 1);
-							Queue.Add(A.OtherNode);
-						}
-					}
-				}
+				const int32 Other = Connections[c].Opposite;
+				if (Other == -1 || NodeDepth[Other] != -1) { continue; }
+				NodeDepth[Other] = NextDepth;
+				Queue.Add(Other);
 			}
 		}
+	}
 
-		// Orient chains based on depth ordering
-		for (int32 i = 0; i < NumChains; i++)
-		{
-			const auto& Chain = ProcessedChains[i];
-			if (!Chain) { continue; }
+	bool FProcessor::OrientChain(const int32 ChainIndex) const
+	{
+		const auto& Chain = ProcessedChains[ChainIndex];
+		if (!Chain) { return false; }
 
-			const int32 SN = Chain->Seed.Node;
-			const int32 EN = Chain->Links.Last().Node;
-			const bool bSeedIsLeaf = Cluster->GetNode(SN)->IsLeaf();
-			const bool bEndIsLeaf = Cluster->GetNode(EN)->IsLeaf();
+		int32 StartNode = Chain->Seed.Node;
+		int32 EndNode = Chain->Links.Last().Node;
 
-			if (bSeedIsLeaf && !bEndIsLeaf)
-			{
-				// Seed is leaf, End is polygon → flow leaf→polygon → no reverse
-				OutReversed[i] = false;
-			}
-			else if (!bSeedIsLeaf && bEndIsLeaf)
-			{
-				// Seed is polygon, End is leaf → flow leaf→polygon → reverse
-				OutReversed[i] = true;
-			}
-			else if (!bSeedIsLeaf && !bEndIsLeaf)
+		switch (Settings->OrientationMode)
+		{
+		case EPCGExZGOrientationMode::DepthFirst:
 			{
-				// Both polygon nodes → flow from lower BFS depth to higher
-				const int32 SeedDepth = NodeDepth.FindRef(SN);
-				const int32 EndDepth = NodeDepth.FindRef(EN);
+				const bool bSeedIsLeaf = Cluster->GetNode(StartNode)->IsLeaf();
+				const bool bEndIsLeaf = Cluster->GetNode(EndNode)->IsLeaf();
 
-				if (SeedDepth > EndDepth || (SeedDepth == EndDepth && SN > EN))
+				bool bReversed = false;
+
+				if (bSeedIsLeaf && !bEndIsLeaf)
+				{
+					// Seed is leaf, End is polygon → flow leaf→polygon → no reverse
+					bReversed = false;
+				}
+				else if (!bSeedIsLeaf && bEndIsLeaf)
+				{
+					// Seed is polygon, End is leaf → flow leaf→polygon → reverse
+					bReversed = true;
+				}
+				else if (!bSeedIsLeaf && !bEndIsLeaf)
 				{
-					OutReversed[i] = true;
+					// Both polygon nodes → flow from lower BFS depth to higher
+					const int32 SeedDepth = NodeDepth[StartNode];
+					const int32 EndDepth = NodeDepth[EndNode];
+
+					if (SeedDepth > EndDepth || (SeedDepth == EndDepth && StartNode > EndNode))
+					{
+						bReversed = true;
+					}
 				}
+				// Both leaf → keep default (false)
+
+				return bReversed != Settings->bInvertOrientation;
+			}
+
+		case EPCGExZGOrientationMode::GlobalDirection:
+			{
+				const FVector RoadDir = (Cluster->GetPos(EndNode) - Cluster->GetPos(StartNode)).GetSafeNormal();
+				return (FVector::DotProduct(RoadDir, Settings->OrientationDirection) < 0) != Settings->bInvertOrientation;
 			}
-			// Both leaf → keep default (false)
+
+		default: // SortDirection
+			return DirectionSettings.SortExtrapolation(Cluster.Get(), Chain->Seed.Edge, StartNode, EndNode);
 		}
 	}
 
-	FZoneLaneProfileRef FProcessor::ResolveLaneProfileByName(FName ProfileName) const
+	int32 FProcessor::ResolveLaneProfileIndex(FName ProfileName) const
+	{
+		if (ProfileName.IsNone()) { return 0; }
+		if (const int32* Found = Context->LaneProfileMap.Find(ProfileName)) { return *Found; }
+		return -1;
+	}
+
+	void FProcessor::AssignUnknownLaneProfileBuckets()
 	{
-		if (ProfileName.IsNone()) { return Settings->LaneProfile; }
-		if (const FZoneLaneProfileRef* Found = Context->LaneProfileMap.Find(ProfileName))
+		// Unregistered names resolve to the default profile, but each still votes under its own name.
+		// Their buckets follow the interned table, in order of first edge.
+		TMap<FName, int32> UnknownBuckets;
+		NumLaneProfileBuckets = Context->LaneProfiles.Num();
+
+		for (int32 i = 0; i < NumEdges; i++)
 		{
-			return *Found;
+			if (EdgeLaneProfiles[i] != -1) { continue; }
+
+			const FName ProfileName = EdgeLaneProfileBuffer->Read(Cluster->GetEdge(i)->PointIndex);
+			if (const int32* Found = UnknownBuckets.Find(ProfileName)) { EdgeLaneProfiles[i] = *Found; }
+			else { EdgeLaneProfiles[i] = UnknownBuckets.Add(ProfileName, NumLaneProfileBuckets++); }
 		}
-		return Settings->LaneProfile;
 	}
 
 	void FProcessor::Cleanup()
 	{
 		TProcessor<FPCGExClusterToZoneGraphContext, UPCGExClusterToZoneGraphSettings>::Cleanup();
 		TargetActor = nullptr;
+		CachedChains.Reset();
 		ProcessedChains.Empty();
+		ChainReversed.Empty();
+		ReleaseStaging();
 		Roads.Empty();
 		Polygons.Empty();
+		Connections.Empty();
+		ConnectorStart.Empty();
 
 		PolygonRadiusBuffer.Reset();
 		PolygonRoutingTypeBuffer.Reset();
@@ -1069,6 +3176,7 @@ namespace PCGExClusterToZoneGraph
 		RoadPointTypeBuffer.Reset();
 		AdditionalIntersectionTagsBuffer.Reset();
 		EdgeLaneProfileBuffer.Reset();
+		EdgeLaneProfiles.Empty();
 		TangentLengthGetter.Reset();
 	}
 
@@ -0,0 +1,419 @@
+﻿// Copyright 2025 Timothé Lapetite and contributors
+// Released under the MIT license https://opensource.org/license/MIT/
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Data/PCGExData.h"
+#include "Details/PCGExSettingsDetails.h"
+#include "Graph/PCGExClusterToZoneGraph.h"
+
+/** Road precompute kernels, shared with the module's automation tests.
+ * Vector math runs four staged points per register over split X/Y/Z lanes, with selects in place of branches.
+ * Endpoints and loop wrap-around are peeled out of the blocked loops and run scalar. */
+namespace PCGExClusterToZoneGraph::Kernels
+{
+	/** Interleaves the low 10 bits of each cell coordinate into a 30-bit Z-order key. */
+	uint32 MortonCode(const FVector& Cell);
+
+	constexpr int32 NumLanes = 4;
+
+	/** Register type matching the precision of a kernel */
+	template <typename T>
+	using TReg = TVectorRegisterType<T>;
+
+	/** Four vectors held as one register per axis. */
+	template <typename T>
+	struct TLanes
+	{
+		TReg<T> X;
+		TReg<T> Y;
+		TReg<T> Z;
+
+		static FORCEINLINE TLanes Load(const TSplitVectors<T>& Vectors, const int32 Index)
+		{
+			return {VectorLoad(Vectors.X.GetData() + Index), VectorLoad(Vectors.Y.GetData() + Index), VectorLoad(Vectors.Z.GetData() + Index)};
+		}
+
+		FORCEINLINE void Store(TSplitVectors<T>& Vectors, const int32 Index) const
+		{
+			VectorStore(X, Vectors.X.GetData() + Index);
+			VectorStore(Y, Vectors.Y.GetData() + Index);
+			VectorStore(Z, Vectors.Z.GetData() + Index);
+		}
+
+		FORCEINLINE TLanes operator+(const TLanes& Other) const { return {VectorAdd(X, Other.X), VectorAdd(Y, Other.Y), VectorAdd(Z, Other.Z)}; }
+		FORCEINLINE TLanes operator-(const TLanes& Other) const { return {VectorSubtract(X, Other.X), VectorSubtract(Y, Other.Y), VectorSubtract(Z, Other.Z)}; }
+		FORCEINLINE TReg<T> SizeSquared() const { return VectorMultiplyAdd(X, X, VectorMultiplyAdd(Y, Y, VectorMultiply(Z, Z))); }
+	};
+
+	/** Branch-free GetSafeNormal of four vectors: lanes shorter than UE_SMALL_NUMBER select Fallback instead.
+	 * Lane lengths are returned in OutLength. */
+	template <typename T>
+	FORCEINLINE TLanes<T> SafeNormal(const TLanes<T>& Vector, const TLanes<T>& Fallback, TReg<T>& OutLength)
+	{
+		const TReg<T> SizeSquared = Vector.SizeSquared();
+		OutLength = VectorSqrt(SizeSquared);
+		const TReg<T> Mask = VectorCompareGT(SizeSquared, VectorSetFloat1(static_cast<T>(UE_SMALL_NUMBER)));
+		return {
+			VectorSelect(Mask, VectorDivide(Vector.X, OutLength), Fallback.X),
+			VectorSelect(Mask, VectorDivide(Vector.Y, OutLength), Fallback.Y),
+			VectorSelect(Mask, VectorDivide(Vector.Z, OutLength), Fallback.Z)};
+	}
+
+	/** Shape point rotation for a forward direction, with world up. */
+	FRotator MakeShapeRotation(const FVector& Forward);
+
+	/** Chord-averaged direction hints. Segment directions are normalized once into split lanes (the last slot holds the
+	 * loop wrap-around), then blended four points at a time. */
+	void ComputeChordForwards(const FVector* Positions, FVector* Forwards, const int32 Num, const bool bLoop, FPrecomputeScratch& Scratch);
+
+	/** Shape point rotations from staged forwards, with world up. Pitch and yaw are solved four forwards at a time,
+	 * near-vertical and zero forwards fall back to the shape point, which picks another up axis for them. */
+	void BuildRotations(const FVector* Forwards, FRotator* Rotations, const int32 Num);
+
+	/** Auto/CatmullRom tangents over a staged point range.
+	 * Open chains mirror their missing neighbor at the peeled endpoints.
+	 * Single precision runs relative to the first point, so large world coordinates keep their fraction. */
+	template <typename T, bool bCatmullRom>
+	void ComputeSmoothTangents(const FVector* Positions, FVector* Forwards, float* TangentLengths, const int32 Num, const bool bLoop, const double Scale, FPrecomputeScratch& Scratch)
+	{
+		TKernelLanes<T>& Lanes = Scratch.GetLanes<T>();
+		const FVector Origin = std::is_same_v<T, float> ? Positions[0] : FVector::ZeroVector;
+		Lanes.Points.Split(Positions, Num, Origin);
+		Lanes.Directions.Split(Forwards, Num, FVector::ZeroVector); // Kept where the neighbors coincide
+		Lanes.Lengths.SetNumUninitialized(Num + NumLanes, EAllowShrinking::No);
+
+		const TReg<T> LengthScale = VectorSetFloat1(static_cast<T>(bCatmullRom ? Scale / 6.0 : Scale * 0.5 / 3.0));
+
+		// Interior points
+		for (int32 k = 1; k < Num - 1; k += NumLanes)
+		{
+			const TLanes<T> Prev = TLanes<T>::Load(Lanes.Points, k - 1);
+			const TLanes<T> Next = TLanes<T>::Load(Lanes.Points, k + 1);
+
+			// Smooth tangent direction — override rotation, unless the neighbors coincide
+			TReg<T> Chord;
+			SafeNormal<T>(Next - Prev, TLanes<T>::Load(Lanes.Directions, k), Chord).Store(Lanes.Directions, k);
+
+			// Tangent magnitude
+			if constexpr (bCatmullRom)
+			{
+				VectorStore(VectorMultiply(Chord, LengthScale), Lanes.Lengths.GetData() + k);
+			}
+			else // Auto
+			{
+				const TLanes<T> Current = TLanes<T>::Load(Lanes.Points, k);
+				const TReg<T> DistPrev = VectorSqrt((Current - Prev).SizeSquared());
+				const TReg<T> DistNext = VectorSqrt((Next - Current).SizeSquared());
+				VectorStore(VectorMultiply(VectorAdd(DistPrev, DistNext), LengthScale), Lanes.Lengths.GetData() + k);
+			}
+		}
+
+		for (int32 k = 1; k < Num - 1; k++)
+		{
+			Forwards[k] = Lanes.Directions.Get(k);
+			TangentLengths[k] = static_cast<float>(Lanes.Lengths[k]);
+		}
+
+		auto TangentAt = [&](const FVector& Prev, const FVector& Current, const FVector& Next, const int32 Index)
+		{
+			const FVector Chord = Next - Prev;
+			const double ChordSquared = Chord.SizeSquared();
+			if (ChordSquared > UE_SMALL_NUMBER) { Forwards[Index] = Chord / FMath::Sqrt(ChordSquared); }
+
+			if constexpr (bCatmullRom) { TangentLengths[Index] = FMath::Sqrt(ChordSquared) / 6.0 * Scale; }
+			else { TangentLengths[Index] = (FVector::Dist(Current, Prev) + FVector::Dist(Next, Current)) * 0.5 / 3.0 * Scale; }
+		};
+
+		const FVector First = Lanes.Points.Get(0);
+		const FVector Last = Lanes.Points.Get(Num - 1);
+
+		// First point
+		{
+			const FVector Next = Lanes.Points.Get(1);
+			TangentAt(bLoop ? Last : First - (Next - First), First, Next, 0); // mirror
+		}
+
+		// Last point
+		{
+			const FVector Before = Lanes.Points.Get(Num - 2);
+			TangentAt(Before, Last, bLoop ? First : Last + (Last - Before), Num - 1); // mirror
+		}
+	}
+
+	/** Majority vote of the lane profile buckets along a chain's links.
+	 * Ties go to the bucket seen first along the chain. Counts are left zeroed after each vote,
+	 * so the scratch histogram only needs sizing once. */
+	template <typename TLinks>
+	int32 VoteLaneProfile(const TLinks& Links, const TConstArrayView<int32> EdgeBuckets, const int32 NumBuckets, FPrecomputeScratch& Scratch)
+	{
+		TScratchArray<int32>& ProfileCounts = Scratch.ProfileCounts;
+		if (ProfileCounts.IsEmpty()) { ProfileCounts.SetNumZeroed(NumBuckets); }
+
+		TScratchArray<int32>& SeenProfiles = Scratch.SeenProfiles;
+		SeenProfiles.Reset();
+
+		for (const auto& Link : Links)
+		{
+			if (Link.Edge < 0) { continue; }
+			const int32 Profile = EdgeBuckets[Link.Edge];
+			if (ProfileCounts[Profile]++ == 0) { SeenProfiles.Add(Profile); }
+		}
+
+		int32 Winner = 0;
+		int32 MaxCount = 0;
+		for (const int32 Profile : SeenProfiles)
+		{
+			if (ProfileCounts[Profile] > MaxCount)
+			{
+				MaxCount = ProfileCounts[Profile];
+				Winner = Profile;
+			}
+		}
+
+		for (const int32 Profile : SeenProfiles) { ProfileCounts[Profile] = 0; }
+
+		return Winner;
+	}
+}
+
+namespace PCGExClusterToZoneGraph
+{
+	template <bool bHasTypeBuffer, ERoadTangentKernel TangentKernel, bool bTrim, bool bClosedLoop, typename TNodes>
+	void FZGRoad::PrecomputeNodes(const TNodes& InNodes, const FRoadPrecomputeParams& Params, FPrecomputeScratch& Scratch)
+	{
+		const FZoneShapePointType DefaultPointType = Params.PointType;
+		const TArray<int32>& Nodes = Scratch.Nodes;
+		const int32 ChainSize = Nodes.Num();
+
+		check(ChainSize <= PointCapacity);
+		NumPoints = ChainSize;
+
+		FShapePointBuffer& Staging = *Params.Staging;
+		FVector* Positions = Staging.Positions.GetData() + PointOffset;
+		FVector* Forwards = Staging.Forwards.GetData() + PointOffset;
+		float* TangentLengths = Staging.TangentLengths.GetData() + PointOffset;
+		FZoneShapePointType* Types = Staging.Types.GetData() + PointOffset;
+
+		for (int i = 0; i < ChainSize; i++)
+		{
+			const int32 NodePointIndex = InNodes.GetPointIndex(Nodes[i]);
+
+			Positions[i] = InNodes.GetPos(Nodes[i]);
+
+			if constexpr (bHasTypeBuffer) { Types[i] = static_cast<FZoneShapePointType>(FMath::Clamp(Params.PointTypeBuffer->Read(NodePointIndex), 0, 3)); }
+			else { Types[i] = DefaultPointType; }
+
+			if constexpr (TangentKernel == ERoadTangentKernel::Manual) { TangentLengths[i] = Params.TangentLengthGetter->Read(NodePointIndex) * Params.TangentLengthScale; }
+			else if constexpr (TangentKernel == ERoadTangentKernel::ManualConstant) { TangentLengths[i] = Params.ConstantTangentLength; }
+			else { TangentLengths[i] = 0; }
+		}
+
+		// Average of prev→current and current→next for a smoother direction hint.
+		// Open chains: endpoints fall back to single-neighbor chord.
+		Kernels::ComputeChordForwards(Positions, Forwards, ChainSize, bClosedLoop, Scratch);
+
+		if constexpr (!bClosedLoop)
+		{
+			const double BufferSq = Params.EndpointTrimBuffer * Params.EndpointTrimBuffer;
+			constexpr bool bLerpTangents = TangentKernel == ERoadTangentKernel::Manual || TangentKernel == ERoadTangentKernel::ManualConstant;
+
+			// Trimming is resolved as an index window over the staged points, with optional
+			// start/end crossing points. The staging range is only compacted once, at the end.
+			int32 WindowStart = 0;
+			bool bHasStartCrossing = false;
+			FVector StartCrossingPos = FVector::ZeroVector;
+			FVector StartCrossingDir = FVector::ZeroVector;
+			float StartCrossingTL = 0;
+
+			// --- Start endpoint ---
+			if (!InNodes.IsLeaf(Nodes[0]))
+			{
+				if (bTrim && StartEndpoint.bValid)
+				{
+					// Walk backward from end to find the outermost half-space boundary crossing.
+					double ProjJ = (Positions[NumPoints - 1] - StartEndpoint.PolygonCenter) | StartEndpoint.Direction;
+
+					for (int32 j = NumPoints - 1; j > 0; j--)
+					{
+						const double ProjPrev = (Positions[j - 1] - StartEndpoint.PolygonCenter) | StartEndpoint.Direction;
+
+						if (ProjJ >= StartEndpoint.Radius && ProjPrev < StartEndpoint.Radius)
+						{
+							WindowStart = j;
+
+							// Snap to polygon connector position for exact alignment
+							StartCrossingPos = StartEndpoint.PolygonCenter + StartEndpoint.Direction * StartEndpoint.Radius;
+							StartCrossingDir = (Positions[j] - StartCrossingPos).GetSafeNormal();
+							if (StartCrossingDir.IsNearlyZero()) { StartCrossingDir = StartEndpoint.Direction; }
+
+							if constexpr (bLerpTangents)
+							{
+								const double Alpha = (StartEndpoint.Radius - ProjPrev) / (ProjJ - ProjPrev);
+								StartCrossingTL = FMath::Lerp(static_cast<double>(TangentLengths[j - 1]), static_cast<double>(TangentLengths[j]), Alpha);
+							}
+
+							// Skip nearby points that would cause auto-bezier bulging
+							if (BufferSq > 0)
+							{
+								while (NumPoints - WindowStart > 1 && (Positions[WindowStart] - StartCrossingPos).SizeSquared() < BufferSq) { WindowStart++; }
+							}
+
+							bHasStartCrossing = true;
+							break;
+						}
+
+						ProjJ = ProjPrev;
+					}
+
+					if (!bHasStartCrossing)
+					{
+						const double FirstProj = (Positions[0] - StartEndpoint.PolygonCenter) | StartEndpoint.Direction;
+						if (FirstProj < StartEndpoint.Radius)
+						{
+							bDegenerate = true;
+							return;
+						}
+					}
+				}
+				else
+				{
+					const FRotator Rotation = Kernels::MakeShapeRotation(Forwards[0]);
+					if (bIsReversed) { Positions[0] += Rotation.RotateVector(FVector::BackwardVector) * StartRadius; }
+					else { Positions[0] += Rotation.RotateVector(FVector::ForwardVector) * StartRadius; }
+				}
+			}
+
+			// Logical view of the start-trimmed road: [StartCrossing?] + Staged[WindowStart..]
+			const int32 CrossingOffset = bHasStartCrossing ? 1 : 0;
+			const int32 NumWindow = NumPoints - WindowStart + CrossingOffset;
+			auto WindowIndex = [&](const int32 k) { return WindowStart + k - CrossingOffset; };
+			auto WindowPos = [&](const int32 k) -> FVector& { return k < CrossingOffset ? StartCrossingPos : Positions[WindowIndex(k)]; };
+			auto WindowTL = [&](const int32 k) -> float { return k < CrossingOffset ? StartCrossingTL : TangentLengths[WindowIndex(k)]; };
+
+			int32 NumKept = NumWindow;
+			bool bHasEndCrossing = false;
+			FVector EndCrossingPos = FVector::ZeroVector;
+			FVector EndCrossingDir = FVector::ZeroVector;
+			float EndCrossingTL = 0;
+
+			// --- End endpoint ---
+			if (!InNodes.IsLeaf(Nodes[ChainSize - 1]))
+			{
+				if (bTrim && EndEndpoint.bValid)
+				{
+					// Walk backward from end to find the outermost half-space boundary crossing.
+					// Walking backward (not forward) prevents removing valid outside points
+					// that appear after an intermediate inside dip on curved roads.
+					double ProjJ = (WindowPos(NumWindow - 1) - EndEndpoint.PolygonCenter) | EndEndpoint.Direction;
+
+					for (int32 j = NumWindow - 1; j > 0; j--)
+					{
+						const double ProjPrev = (WindowPos(j - 1) - EndEndpoint.PolygonCenter) | EndEndpoint.Direction;
+
+						if (ProjJ < EndEndpoint.Radius && ProjPrev >= EndEndpoint.Radius)
+						{
+							NumKept = j;
+
+							// Snap to polygon connector position for exact alignment
+							EndCrossingPos = EndEndpoint.PolygonCenter + EndEndpoint.Direction * EndEndpoint.Radius;
+							EndCrossingDir = (EndCrossingPos - WindowPos(j - 1)).GetSafeNormal();
+							if (EndCrossingDir.IsNearlyZero()) { EndCrossingDir = -EndEndpoint.Direction; }
+
+							if constexpr (bLerpTangents)
+							{
+								const double Alpha = (EndEndpoint.Radius - ProjPrev) / (ProjJ - ProjPrev);
+								EndCrossingTL = FMath::Lerp(static_cast<double>(WindowTL(j - 1)), static_cast<double>(WindowTL(j)), Alpha);
+							}
+
+							// Drop nearby points that would cause auto-bezier bulging
+							if (BufferSq > 0)
+							{
+								while (NumKept > 1 && (WindowPos(NumKept - 1) - EndCrossingPos).SizeSquared() < BufferSq) { NumKept--; }
+							}
+
+							bHasEndCrossing = true;
+							break;
+						}
+
+						ProjJ = ProjPrev;
+					}
+
+					if (!bHasEndCrossing)
+					{
+						const double LastProj = (WindowPos(NumWindow - 1) - EndEndpoint.PolygonCenter) | EndEndpoint.Direction;
+						if (LastProj < EndEndpoint.Radius)
+						{
+							bDegenerate = true;
+							return;
+						}
+					}
+				}
+				else
+				{
+					const int32 LastIndex = WindowIndex(NumWindow - 1);
+					const FRotator Rotation = Kernels::MakeShapeRotation(Forwards[LastIndex]);
+					if (bIsReversed) { Positions[LastIndex] += Rotation.RotateVector(FVector::ForwardVector) * EndRadius; }
+					else { Positions[LastIndex] += Rotation.RotateVector(FVector::BackwardVector) * EndRadius; }
+				}
+			}
+
+			// Single compaction pass into the final window.
+			// Source indices never trail destination indices, so an in-place forward copy is safe.
+			const int32 Shift = WindowStart - CrossingOffset;
+			if (Shift > 0)
+			{
+				for (int32 k = CrossingOffset; k < NumKept; k++)
+				{
+					Positions[k] = Positions[k + Shift];
+					Forwards[k] = Forwards[k + Shift];
+					TangentLengths[k] = TangentLengths[k + Shift];
+					Types[k] = Types[k + Shift];
+				}
+			}
+
+			if (bHasStartCrossing)
+			{
+				Positions[0] = StartCrossingPos;
+				Forwards[0] = StartCrossingDir;
+				TangentLengths[0] = StartCrossingTL;
+				Types[0] = DefaultPointType;
+			}
+
+			if (bHasEndCrossing)
+			{
+				Positions[NumKept] = EndCrossingPos;
+				Forwards[NumKept] = EndCrossingDir;
+				TangentLengths[NumKept] = EndCrossingTL;
+				Types[NumKept] = DefaultPointType;
+				NumKept++;
+			}
+
+			NumPoints = NumKept;
+
+			// Failsafe: ZoneGraph requires at least 2 shape points
+			if (NumPoints < 2)
+			{
+				bDegenerate = true;
+			}
+		}
+
+		if (bDegenerate) { return; }
+
+		// --- Auto/CatmullRom tangent pass ---
+		// Computed from final staged positions (after trimming, crossing points included).
+		// Also overrides rotation with smooth tangent direction for Bezier point types.
+		if constexpr (TangentKernel == ERoadTangentKernel::Auto || TangentKernel == ERoadTangentKernel::CatmullRom)
+		{
+			constexpr bool bCatmullRom = TangentKernel == ERoadTangentKernel::CatmullRom;
+			const double Scale = Params.TangentLengthScale;
+
+			if (Params.bFloatPrecisionTangents) { Kernels::ComputeSmoothTangents<float, bCatmullRom>(Positions, Forwards, TangentLengths, NumPoints, bClosedLoop, Scale, Scratch); }
+			else { Kernels::ComputeSmoothTangents<double, bCatmullRom>(Positions, Forwards, TangentLengths, NumPoints, bClosedLoop, Scale, Scratch); }
+		}
+
+		Kernels::BuildRotations(Forwards, Staging.Rotations.GetData() + PointOffset, NumPoints);
+	}
+}
+
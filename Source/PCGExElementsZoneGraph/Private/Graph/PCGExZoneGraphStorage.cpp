@@ -0,0 +1,255 @@
+﻿// Copyright 2025 Timothé Lapetite and contributors
+// Released under the MIT license https://opensource.org/license/MIT/
+
+#include "Graph/PCGExZoneGraphStorage.h"
+
+#include "ZoneGraphData.h"
+#include "ZoneGraphSettings.h"
+#include "ZoneGraphSubsystem.h"
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+
+namespace PCGExZoneGraphStorage
+{
+	// Matched connectors share a profile, so their lanes sit at the same offsets up to float error
+	constexpr double LaneOffsetToleranceSquared = 1.0;
+
+	int32 FChunk::AddSpline(TConstArrayView<FZoneShapePoint> InPoints, const FZoneLaneProfile& InProfile, const FZoneGraphTagMask InTags)
+	{
+		const int32 NumZones = Storage.Zones.Num();
+		UE::ZoneShape::Utilities::TessellateSplineShape(InPoints, InProfile, InTags, LocalToWorld, Storage, Links);
+		if (Storage.Zones.Num() == NumZones) { return -1; }
+
+		// Both spline ends are connectors
+		AddConnector(InPoints[0], InProfile);
+		AddConnector(InPoints.Last(), InProfile);
+		return FinishZone(NumZones);
+	}
+
+	int32 FChunk::AddPolygon(TConstArrayView<FZoneShapePoint> InPoints, const EZoneShapePolygonRoutingType InRoutingType, TConstArrayView<FZoneLaneProfile> InProfiles, const FZoneGraphTagMask InTags)
+	{
+		const int32 NumZones = Storage.Zones.Num();
+		UE::ZoneShape::Utilities::TessellatePolygonShape(InPoints, InRoutingType, InProfiles, InTags, LocalToWorld, Storage, Links);
+		if (Storage.Zones.Num() == NumZones) { return -1; }
+
+		// Only lane profile points are polygon connectors
+		for (int32 i = 0; i < InPoints.Num(); i++)
+		{
+			if (InPoints[i].Type == FZoneShapePointType::LaneProfile) { AddConnector(InPoints[i], InProfiles[i]); }
+		}
+		return FinishZone(NumZones);
+	}
+
+	int32 FChunk::FinishZone(const int32 InNumZones)
+	{
+		// Every zone comes through here right after its connectors, so zone indices double as range indices
+		if (ConnectorStarts.IsEmpty()) { ConnectorStarts.Add(0); }
+		ConnectorStarts.Add(Connectors.Num());
+		return InNumZones;
+	}
+
+	void FChunk::AddConnector(const FZoneShapePoint& InPoint, const FZoneLaneProfile& InProfile)
+	{
+		FConnector& Connector = Connectors.Emplace_GetRef();
+		Connector.Position = LocalToWorld.TransformPosition(InPoint.Position);
+		Connector.Profile = InProfile.ID;
+		Connector.HalfWidth = InProfile.GetLanesTotalWidth() * 0.5;
+	}
+
+	void FChunk::ConnectZones(const int32 ZoneA, const int32 ZoneB)
+	{
+		const FZoneGraphBuildSettings& BuildSettings = GetDefault<UZoneGraphSettings>()->GetBuildSettings();
+		const double SnapDistanceSquared = FMath::Square(BuildSettings.ConnectionSnapDistance);
+		const double SnapAngleCos = FMath::Cos(FMath::DegreesToRadians(BuildSettings.ConnectionSnapAngle));
+
+		// Shapes only connect where two of their connectors meet with the same lane profile
+		for (int32 a = ConnectorStarts[ZoneA]; a < ConnectorStarts[ZoneA + 1]; a++)
+		{
+			const FConnector& A = Connectors[a];
+			for (int32 b = ConnectorStarts[ZoneB]; b < ConnectorStarts[ZoneB + 1]; b++)
+			{
+				const FConnector& B = Connectors[b];
+				if (A.Profile != B.Profile || FVector::DistSquared(A.Position, B.Position) > SnapDistanceSquared) { continue; }
+
+				LinkLanes(A, ZoneA, B, ZoneB, SnapAngleCos);
+				LinkLanes(B, ZoneB, A, ZoneA, SnapAngleCos);
+			}
+		}
+	}
+
+	void FChunk::LinkLanes(const FConnector& From, const int32 FromZone, const FConnector& To, const int32 ToZone, const double SnapAngleCos)
+	{
+		// Lanes ending on From continue into lanes starting on To at the same offset from their connector, heading the same way.
+		// Matching offsets rather than positions keeps connectors snapped a few units apart linked, as the builder does.
+		const FZoneData& Source = Storage.Zones[FromZone];
+		const FZoneData& Target = Storage.Zones[ToZone];
+
+		for (int32 i = Source.LanesBegin; i < Source.LanesEnd; i++)
+		{
+			const int32 EndPoint = Storage.Lanes[i].PointsEnd - 1;
+			const FVector EndOffset = Storage.LanePoints[EndPoint] - From.Position;
+			if (EndOffset.SizeSquared() > FMath::Square(From.HalfWidth + 1)) { continue; }
+
+			for (int32 j = Target.LanesBegin; j < Target.LanesEnd; j++)
+			{
+				const int32 StartPoint = Storage.Lanes[j].PointsBegin;
+				if (FVector::DistSquared(EndOffset, Storage.LanePoints[StartPoint] - To.Position) > LaneOffsetToleranceSquared) { continue; }
+				if (FVector::DotProduct(Storage.LaneTangentVectors[EndPoint], Storage.LaneTangentVectors[StartPoint]) < SnapAngleCos) { continue; }
+
+				Links.Emplace(i, FZoneLaneLinkData(j, EZoneLaneLinkType::Outgoing, EZoneLaneLinkFlags::None));
+				Links.Emplace(j, FZoneLaneLinkData(i, EZoneLaneLinkType::Incoming, EZoneLaneLinkFlags::None));
+			}
+		}
+	}
+
+	void FWriter::AddChunk(FChunk&& InChunk)
+	{
+		FScopeLock ScopeLock(&Lock);
+		Chunks.Add(MoveTemp(InChunk));
+	}
+
+	void FWriter::Build()
+	{
+		FScopeLock ScopeLock(&Lock);
+		if (bBuilt) { return; }
+		bBuilt = true;
+
+		// Processors complete in any order, chunks are sorted back by cluster so the output is stable
+		Chunks.Sort([](const FChunk& A, const FChunk& B) { return A.SortKey < B.SortKey; });
+
+		int32 NumZones = 0;
+		int32 NumLanes = 0;
+		int32 NumLanePoints = 0;
+		int32 NumBoundaryPoints = 0;
+		int32 NumLinks = 0;
+
+		for (const FChunk& Chunk : Chunks)
+		{
+			NumZones += Chunk.Storage.Zones.Num();
+			NumLanes += Chunk.Storage.Lanes.Num();
+			NumLanePoints += Chunk.Storage.LanePoints.Num();
+			NumBoundaryPoints += Chunk.Storage.BoundaryPoints.Num();
+			NumLinks += Chunk.Links.Num();
+		}
+
+		Merged.Reset();
+		Merged.Zones.Reserve(NumZones);
+		Merged.Lanes.Reserve(NumLanes);
+		Merged.LanePoints.Reserve(NumLanePoints);
+		Merged.LaneUpVectors.Reserve(NumLanePoints);
+		Merged.LaneTangentVectors.Reserve(NumLanePoints);
+		Merged.LanePointProgressions.Reserve(NumLanePoints);
+		Merged.BoundaryPoints.Reserve(NumBoundaryPoints);
+
+		TArray<FZoneShapeLaneInternalLink> AllLinks;
+		AllLinks.Reserve(NumLinks);
+
+		for (FChunk& Chunk : Chunks)
+		{
+			const int32 ZoneOffset = Merged.Zones.Num();
+			const int32 LaneOffset = Merged.Lanes.Num();
+			const int32 PointOffset = Merged.LanePoints.Num();
+			const int32 BoundaryOffset = Merged.BoundaryPoints.Num();
+
+			for (FZoneData& Zone : Chunk.Storage.Zones)
+			{
+				Zone.BoundaryPointsBegin += BoundaryOffset;
+				Zone.BoundaryPointsEnd += BoundaryOffset;
+				Zone.LanesBegin += LaneOffset;
+				Zone.LanesEnd += LaneOffset;
+			}
+
+			for (FZoneLaneData& Lane : Chunk.Storage.Lanes)
+			{
+				Lane.ZoneIndex += ZoneOffset;
+				Lane.PointsBegin += PointOffset;
+				Lane.PointsEnd += PointOffset;
+			}
+
+			for (FZoneShapeLaneInternalLink& Link : Chunk.Links)
+			{
+				Link.LaneIndex += LaneOffset;
+				Link.LinkData.DestLaneIndex += LaneOffset;
+			}
+
+			Merged.Zones.Append(Chunk.Storage.Zones);
+			Merged.Lanes.Append(Chunk.Storage.Lanes);
+			Merged.LanePoints.Append(Chunk.Storage.LanePoints);
+			Merged.LaneUpVectors.Append(Chunk.Storage.LaneUpVectors);
+			Merged.LaneTangentVectors.Append(Chunk.Storage.LaneTangentVectors);
+			Merged.LanePointProgressions.Append(Chunk.Storage.LanePointProgressions);
+			Merged.BoundaryPoints.Append(Chunk.Storage.BoundaryPoints);
+			AllLinks.Append(Chunk.Links);
+		}
+
+		Chunks.Empty();
+
+		// Each lane owns a contiguous range of links, internal links first in the order they were emitted
+		AllLinks.StableSort();
+		Merged.LaneLinks.Reserve(AllLinks.Num());
+
+		int32 LinkIndex = 0;
+		for (int32 LaneIndex = 0; LaneIndex < Merged.Lanes.Num(); LaneIndex++)
+		{
+			FZoneLaneData& Lane = Merged.Lanes[LaneIndex];
+			Lane.LinksBegin = Merged.LaneLinks.Num();
+			while (LinkIndex < AllLinks.Num() && AllLinks[LinkIndex].LaneIndex == LaneIndex) { Merged.LaneLinks.Add(AllLinks[LinkIndex++].LinkData); }
+			Lane.LinksEnd = Merged.LaneLinks.Num();
+
+			// Lanes leaving into several lanes split, lanes fed by several lanes merge
+			int32 NumOutgoing = 0;
+			int32 NumIncoming = 0;
+			for (int32 l = Lane.LinksBegin; l < Lane.LinksEnd; l++)
+			{
+				NumOutgoing += Merged.LaneLinks[l].Type == EZoneLaneLinkType::Outgoing;
+				NumIncoming += Merged.LaneLinks[l].Type == EZoneLaneLinkType::Incoming;
+			}
+
+			for (int32 l = Lane.LinksBegin; l < Lane.LinksEnd; l++)
+			{
+				FZoneLaneLinkData& LinkData = Merged.LaneLinks[l];
+				if (LinkData.Type == EZoneLaneLinkType::Outgoing && NumOutgoing > 1) { LinkData.SetFlags(LinkData.GetFlags() | EZoneLaneLinkFlags::Splitting); }
+				if (LinkData.Type == EZoneLaneLinkType::Incoming && NumIncoming > 1) { LinkData.SetFlags(LinkData.GetFlags() | EZoneLaneLinkFlags::Merging); }
+			}
+		}
+
+		Merged.Bounds = FBox(ForceInit);
+		for (const FZoneData& Zone : Merged.Zones) { Merged.Bounds += Zone.Bounds; }
+		Merged.ZoneBVTree.Build(MakeStridedView(Merged.Zones, &FZoneData::Bounds));
+	}
+
+	AZoneGraphData* FWriter::Emit(AActor* InTargetActor, const EObjectFlags InFlags)
+	{
+		check(IsInGameThread());
+
+		UWorld* World = InTargetActor ? InTargetActor->GetWorld() : nullptr;
+		if (!World) { return nullptr; }
+
+		FActorSpawnParameters SpawnParams;
+		SpawnParams.OverrideLevel = InTargetActor->GetLevel();
+		SpawnParams.ObjectFlags = InFlags;
+
+		AZoneGraphData* ZoneGraphData = World->SpawnActor<AZoneGraphData>(SpawnParams);
+		if (!ZoneGraphData) { return nullptr; }
+
+		// The actor registers its empty storage on spawn, so it is registered again once filled
+		Apply(*ZoneGraphData);
+
+		return ZoneGraphData;
+	}
+
+	void FWriter::Apply(AZoneGraphData& InZoneGraphData)
+	{
+		check(IsInGameThread());
+
+		UZoneGraphSubsystem* ZoneGraphSubsystem = UWorld::GetSubsystem<UZoneGraphSubsystem>(InZoneGraphData.GetWorld());
+		if (ZoneGraphSubsystem && InZoneGraphData.IsRegistered()) { ZoneGraphSubsystem->UnregisterZoneGraphData(InZoneGraphData); }
+
+		{
+			FScopeLock StorageLock(&InZoneGraphData.GetStorageLock());
+			InZoneGraphData.GetStorageMutable() = MoveTemp(Merged);
+		}
+
+		if (ZoneGraphSubsystem) { ZoneGraphSubsystem->RegisterZoneGraphData(InZoneGraphData); }
+	}
+}
@@ -0,0 +1,416 @@
+﻿// Copyright 2025 Timothé Lapetite and contributors
+// Released under the MIT license https://opensource.org/license/MIT/
+
+#include "Graph/PCGExZoneShapeBake.h"
+
+#include "PCGExElementsZoneGraph.h"
+#include "ZoneGraphData.h"
+#include "ZoneGraphDelegates.h"
+#include "ZoneGraphSettings.h"
+#include "ZoneShapeComponent.h"
+#include "Async/MappedFileHandle.h"
+#include "Engine/Level.h"
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+#include "Graph/PCGExZoneGraphStorage.h"
+#include "HAL/PlatformFileManager.h"
+#include "Misc/FileHelper.h"
+#include "Serialization/CustomVersion.h"
+#include "Misc/PackageName.h"
+#include "Misc/Paths.h"
+
+#if WITH_EDITOR
+#include "Settings/ProjectPackagingSettings.h"
+#endif
+
+namespace PCGExZoneShapeBake
+{
+	int32 FChunk::AddShape(const FShape& InShape, const TArray<FZoneShapePoint>& InPoints)
+	{
+		FShape& Shape = Shapes.Add_GetRef(InShape);
+		Shape.FirstPoint = Points.Num();
+		Shape.NumPoints = InPoints.Num();
+
+		Points.Reserve(Points.Num() + InPoints.Num());
+		for (const FZoneShapePoint& Source : InPoints)
+		{
+			FPoint& Point = Points.Emplace_GetRef();
+			Point.Position = Source.Position;
+			Point.Rotation = Source.Rotation;
+			Point.TangentLength = Source.TangentLength;
+			Point.Type = Source.Type;
+		}
+
+		return Shape.FirstPoint;
+	}
+
+	FWriter::FWriter(const TArray<FZoneLaneProfileRef>& InProfiles)
+	{
+		Profiles.Reserve(InProfiles.Num());
+		for (const FZoneLaneProfileRef& Profile : InProfiles) { Profiles.Add(FProfile{Profile.ID}); }
+	}
+
+	void FWriter::AddChunk(FChunk&& InChunk)
+	{
+		FScopeLock ScopeLock(&Lock);
+		Chunks.Add(MoveTemp(InChunk));
+	}
+
+	void FWriter::Write(TArray<uint8>& OutBlob)
+	{
+		FScopeLock ScopeLock(&Lock);
+
+		// Processors complete in any order, chunks are sorted back by cluster so the output is stable
+		Chunks.Sort([](const FChunk& A, const FChunk& B) { return A.SortKey < B.SortKey; });
+
+		FHeader Header;
+		Header.NumProfiles = Profiles.Num();
+		for (const FChunk& Chunk : Chunks)
+		{
+			Header.NumShapes += Chunk.Shapes.Num();
+			Header.NumPoints += Chunk.Points.Num();
+		}
+
+		OutBlob.Reset(sizeof(FHeader) + Header.NumProfiles * sizeof(FProfile) + Header.NumShapes * sizeof(FShape) + Header.NumPoints * sizeof(FPoint));
+
+		auto Append = [&OutBlob](const void* Data, const int64 Size) { OutBlob.Append(static_cast<const uint8*>(Data), Size); };
+
+		Append(&Header, sizeof(FHeader));
+		Append(Profiles.GetData(), Profiles.Num() * sizeof(FProfile));
+
+		// Point ranges and shape links are chunk-local until written
+		int32 PointBase = 0;
+		int32 ShapeBase = 0;
+		for (const FChunk& Chunk : Chunks)
+		{
+			for (FShape Shape : Chunk.Shapes)
+			{
+				Shape.FirstPoint += PointBase;
+				if (Shape.StartShape != -1) { Shape.StartShape += ShapeBase; }
+				if (Shape.EndShape != -1) { Shape.EndShape += ShapeBase; }
+				Append(&Shape, sizeof(FShape));
+			}
+
+			PointBase += Chunk.Points.Num();
+			ShapeBase += Chunk.Shapes.Num();
+		}
+
+		for (const FChunk& Chunk : Chunks) { Append(Chunk.Points.GetData(), Chunk.Points.Num() * sizeof(FPoint)); }
+	}
+
+	bool FWriter::Save(const FString& InPath)
+	{
+		TArray<uint8> Blob;
+		Write(Blob);
+		return FFileHelper::SaveArrayToFile(Blob, *ResolvePath(InPath));
+	}
+
+	bool FShapesView::Parse(const uint8* InData, const int64 InSize)
+	{
+		if (!InData || InSize < static_cast<int64>(sizeof(FHeader))) { return false; }
+
+		const FHeader* Header = reinterpret_cast<const FHeader*>(InData);
+		if (Header->Magic != Magic || Header->Version != Version) { return false; }
+
+		const int64 ProfilesOffset = sizeof(FHeader);
+		const int64 ShapesOffset = ProfilesOffset + static_cast<int64>(Header->NumProfiles) * sizeof(FProfile);
+		const int64 PointsOffset = ShapesOffset + static_cast<int64>(Header->NumShapes) * sizeof(FShape);
+		const int64 EndOffset = PointsOffset + static_cast<int64>(Header->NumPoints) * sizeof(FPoint);
+		if (EndOffset != InSize) { return false; }
+
+		Profiles = MakeArrayView(reinterpret_cast<const FProfile*>(InData + ProfilesOffset), Header->NumProfiles);
+		Shapes = MakeArrayView(reinterpret_cast<const FShape*>(InData + ShapesOffset), Header->NumShapes);
+		Points = MakeArrayView(reinterpret_cast<const FPoint*>(InData + PointsOffset), Header->NumPoints);
+
+		// Ranges are validated once here, so applying shapes doesn't need to
+		for (const FShape& Shape : Shapes)
+		{
+			// Summed in 64 bits, so a crafted range can't wrap back into bounds
+			if (Shape.FirstPoint < 0 || Shape.NumPoints < 0 || static_cast<int64>(Shape.FirstPoint) + Shape.NumPoints > Points.Num()) { return false; }
+			if (Shape.Type != EShapeType::Spline && Shape.Type != EShapeType::Polygon) { return false; }
+			if (Shape.RoutingType > static_cast<uint8>(EZoneShapePolygonRoutingType::Arcs)) { return false; }
+			if (!Profiles.IsValidIndex(Shape.LaneProfile)) { return false; }
+			if ((Shape.StartShape != -1 && !Shapes.IsValidIndex(Shape.StartShape)) || (Shape.EndShape != -1 && !Shapes.IsValidIndex(Shape.EndShape))) { return false; }
+		}
+
+		for (const FPoint& Point : Points)
+		{
+			if (Point.LaneProfile != NoLaneProfile && !Profiles.IsValidIndex(Point.LaneProfile)) { return false; }
+			if (Point.Type > FZoneShapePointType::LaneProfile) { return false; }
+		}
+
+		return true;
+	}
+
+	FMappedShapes::FMappedShapes() = default;
+	FMappedShapes::~FMappedShapes() = default;
+
+	bool FMappedShapes::Open(const FString& InPath)
+	{
+		const FString Path = ResolvePath(InPath);
+
+		FOpenMappedResult Result = FPlatformFileManager::Get().GetPlatformFile().OpenMappedEx(*Path);
+		if (Result.HasError()) { return false; }
+		Handle = Result.StealValue();
+
+		const int64 FileSize = Handle->GetFileSize();
+		if (FileSize < static_cast<int64>(sizeof(FHeader))) { return false; }
+
+		Region.Reset(Handle->MapRegion(0, FileSize));
+		if (!Region) { return false; }
+
+		return Parse(Region->GetMappedPtr(), FileSize);
+	}
+
+	void FShapesView::EmitTo(PCGExZoneGraphStorage::FChunk& OutChunk, const FZoneGraphTagMask InDefaultTags) const
+	{
+		// Profiles missing from the ZoneGraph settings fall back to an empty profile
+		TArray<FZoneLaneProfile> LaneProfiles;
+		LaneProfiles.Reserve(Profiles.Num());
+		for (const FProfile& Profile : Profiles)
+		{
+			const FZoneLaneProfile* LaneProfile = FindLaneProfile(Profile.ID);
+			LaneProfiles.Add(LaneProfile ? *LaneProfile : FZoneLaneProfile());
+		}
+
+		TArray<FZoneShapePoint> ShapePoints;
+		TArray<FZoneLaneProfile> PointProfiles;
+
+		TArray<int32> Zones;
+		Zones.Init(-1, Shapes.Num());
+
+		for (int32 i = 0; i < Shapes.Num(); i++)
+		{
+			const FShape& Shape = Shapes[i];
+			const FZoneGraphTagMask Tags = InDefaultTags | FZoneGraphTagMask(Shape.AdditionalTags);
+
+			ShapePoints.SetNum(Shape.NumPoints);
+			for (int32 p = 0; p < Shape.NumPoints; p++)
+			{
+				const FPoint& Source = Points[Shape.FirstPoint + p];
+
+				FZoneShapePoint& Point = ShapePoints[p];
+				Point = FZoneShapePoint(Source.Position);
+				Point.Rotation = Source.Rotation;
+				Point.Type = Source.Type;
+				Point.TangentLength = Source.TangentLength;
+			}
+
+			if (Shape.Type == EShapeType::Spline)
+			{
+				Zones[i] = OutChunk.AddSpline(ShapePoints, LaneProfiles[Shape.LaneProfile], Tags);
+				continue;
+			}
+
+			// Polygons take one profile per point, falling back to the shape's common profile
+			PointProfiles.Reset(Shape.NumPoints);
+			for (int32 p = 0; p < Shape.NumPoints; p++)
+			{
+				const uint16 PointProfile = Points[Shape.FirstPoint + p].LaneProfile;
+				PointProfiles.Add(LaneProfiles[PointProfile == NoLaneProfile ? Shape.LaneProfile : PointProfile]);
+			}
+
+			Zones[i] = OutChunk.AddPolygon(ShapePoints, static_cast<EZoneShapePolygonRoutingType>(Shape.RoutingType), PointProfiles, Tags);
+		}
+
+		for (int32 i = 0; i < Shapes.Num(); i++)
+		{
+			if (Zones[i] == -1) { continue; }
+
+			for (const int32 Linked : {Shapes[i].StartShape, Shapes[i].EndShape})
+			{
+				if (Linked != -1 && Zones[Linked] != -1) { OutChunk.ConnectZones(Zones[i], Zones[Linked]); }
+			}
+		}
+	}
+
+	const FZoneLaneProfile* FindLaneProfile(const FGuid& InID)
+	{
+		const UZoneGraphSettings* ZGSettings = GetDefault<UZoneGraphSettings>();
+		if (!ZGSettings) { return nullptr; }
+		return ZGSettings->GetLaneProfiles().FindByPredicate([&](const FZoneLaneProfile& Candidate) { return Candidate.ID == InID; });
+	}
+
+	FString ResolvePath(const FString& InPath)
+	{
+		return FPaths::ConvertRelativePathToFull(FPaths::ProjectDir(), InPath);
+	}
+
+	FString MakeDefaultPath(const AActor* InActor, const FString& InSourceName)
+	{
+		// Package and actor names hold across sessions, so regenerations overwrite their own file
+		const ULevel* Level = InActor ? InActor->GetLevel() : nullptr;
+		const FString LevelName = Level ? FPackageName::GetShortName(Level->GetPackage()) : FString(TEXT("Transient"));
+		const FString FileName = FString::Printf(TEXT("%s_%s.pxzg"), InActor ? *InActor->GetName() : TEXT("None"), *InSourceName);
+		return FPaths::Combine(DefaultDirectory, FPaths::MakeValidFileName(LevelName), FPaths::MakeValidFileName(FileName));
+	}
+
+#if WITH_EDITOR
+	bool StageWithContent(const FString& InPath)
+	{
+		// Packaging directories are relative to the Content directory
+		FString Directory = FPaths::GetPath(ResolvePath(InPath));
+		const FString ContentDir = FPaths::ConvertRelativePathToFull(FPaths::ProjectContentDir());
+		if (!FPaths::IsUnderDirectory(Directory, ContentDir) || !FPaths::MakePathRelativeTo(Directory, *ContentDir)) { return false; }
+
+		UProjectPackagingSettings* Packaging = GetMutableDefault<UProjectPackagingSettings>();
+		const bool bStaged = Packaging->DirectoriesToAlwaysStageAsNonUFS.ContainsByPredicate(
+			[&](const FDirectoryPath& Staged) { return FPaths::IsSamePath(Staged.Path, Directory) || FPaths::IsUnderDirectory(Directory, Staged.Path); });
+
+		if (!bStaged)
+		{
+			FDirectoryPath& Staged = Packaging->DirectoriesToAlwaysStageAsNonUFS.AddDefaulted_GetRef();
+			Staged.Path = Directory;
+			Packaging->TryUpdateDefaultConfigFile();
+		}
+
+		return true;
+	}
+#endif
+
+	void WriteLanes(const FShapesView& InShapes, const USceneComponent* InComponent, PCGExZoneGraphStorage::FWriter& OutWriter)
+	{
+		// Shapes are relative to the component, as shape components attached to it would be
+		PCGExZoneGraphStorage::FChunk Chunk;
+		Chunk.LocalToWorld = InComponent->GetComponentTransform().ToMatrixWithScale();
+		InShapes.EmitTo(Chunk, GetDefault<UZoneShapeComponent>()->GetTags());
+		OutWriter.AddChunk(MoveTemp(Chunk));
+	}
+}
+
+/** Versions of the packed shapes blob saved by container components. */
+struct FPCGExZoneShapeContainerVersion
+{
+	enum Type : int32
+	{
+		// Raw blob, before the version was recorded
+		BeforeCustomVersion = 0,
+		// Version recorded with the blob, checked against the baked layout header on load
+		VersionedBlob,
+
+		VersionPlusOne,
+		LatestVersion = VersionPlusOne - 1
+	};
+
+	static const FGuid GUID;
+};
+
+const FGuid FPCGExZoneShapeContainerVersion::GUID(0x6A3F1C52, 0x4E8B4D17, 0x9B2C7E35, 0xD1F08A64);
+static FCustomVersionRegistration GRegisterPCGExZoneShapeContainerVersion(FPCGExZoneShapeContainerVersion::GUID, FPCGExZoneShapeContainerVersion::LatestVersion, TEXT("PCGExZoneShapeContainer"));
+
+void UPCGExZoneLanesComponent::EmitLanes()
+{
+	check(IsInGameThread());
+
+	UWorld* World = GetWorld();
+	if (!GetOwner() || !World || World->bIsTearingDown || IsValid(ZoneGraphData)) { return; }
+
+	PCGExZoneGraphStorage::FWriter Writer;
+	if (!WriteLanes(Writer)) { return; }
+	Writer.Build();
+
+	ZoneGraphData = Writer.Emit(GetOwner(), RF_Transient | RF_TextExportTransient | RF_DuplicateTransient);
+
+#if WITH_EDITOR
+	if (ZoneGraphData && !World->IsGameWorld() && !BuildDoneHandle.IsValid())
+	{
+		BuildDoneHandle = UE::ZoneGraphDelegates::OnZoneGraphDataBuildDone.AddUObject(this, &UPCGExZoneLanesComponent::OnZoneGraphBuildDone);
+	}
+#endif
+}
+
+void UPCGExZoneLanesComponent::ReleaseLanes()
+{
+#if WITH_EDITOR
+	if (BuildDoneHandle.IsValid())
+	{
+		UE::ZoneGraphDelegates::OnZoneGraphDataBuildDone.Remove(BuildDoneHandle);
+		BuildDoneHandle.Reset();
+	}
+#endif
+
+	const UWorld* World = GetWorld();
+	if (IsValid(ZoneGraphData) && World && !World->bIsTearingDown) { ZoneGraphData->Destroy(); }
+	ZoneGraphData = nullptr;
+}
+
+void UPCGExZoneLanesComponent::BeginPlay()
+{
+	Super::BeginPlay();
+	EmitLanes();
+}
+
+void UPCGExZoneLanesComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	ReleaseLanes();
+	Super::EndPlay(EndPlayReason);
+}
+
+void UPCGExZoneLanesComponent::OnComponentDestroyed(const bool bDestroyingHierarchy)
+{
+	ReleaseLanes();
+	Super::OnComponentDestroyed(bDestroyingHierarchy);
+}
+
+#if WITH_EDITOR
+void UPCGExZoneLanesComponent::OnZoneGraphBuildDone(const FZoneGraphBuildData& InBuildData)
+{
+	// The builder hands every ZoneGraph Data of the level the zones it built from shape components, ours included
+	if (!IsValid(ZoneGraphData)) { return; }
+
+	PCGExZoneGraphStorage::FWriter Writer;
+	if (!WriteLanes(Writer)) { return; }
+	Writer.Build();
+	Writer.Apply(*ZoneGraphData);
+}
+#endif
+
+bool UPCGExBakedZoneShapesComponent::WriteLanes(PCGExZoneGraphStorage::FWriter& OutWriter) const
+{
+	if (BakedFile.IsEmpty()) { return false; }
+
+	// Lanes are read straight from the mapped file, which is released once tessellated
+	PCGExZoneShapeBake::FMappedShapes Baked;
+	if (!Baked.Open(BakedFile))
+	{
+		UE_LOG(LogPCGExZoneGraph, Warning, TEXT("Could not load baked zone shapes from '%s'."), *BakedFile);
+		return false;
+	}
+
+	PCGExZoneShapeBake::WriteLanes(Baked, this, OutWriter);
+	return true;
+}
+
+void UPCGExZoneShapeContainerComponent::Serialize(FArchive& Ar)
+{
+	Super::Serialize(Ar);
+
+	Ar.UsingCustomVersion(FPCGExZoneShapeContainerVersion::GUID);
+	Ar << PackedShapes;
+
+	if (Ar.IsLoading() && !PackedShapes.IsEmpty())
+	{
+		// Unversioned blobs share the current layout, anything failing the header check is dropped rather than read as shapes
+		PCGExZoneShapeBake::FShapesView Packed;
+		if (!Packed.Parse(PackedShapes.GetData(), PackedShapes.Num()))
+		{
+			UE_LOG(LogPCGExZoneGraph, Warning, TEXT("Discarded invalid packed zone shapes on '%s', regenerate to restore them."), *GetPathName());
+			PackedShapes.Empty();
+		}
+	}
+}
+
+bool UPCGExZoneShapeContainerComponent::WriteLanes(PCGExZoneGraphStorage::FWriter& OutWriter) const
+{
+	if (PackedShapes.IsEmpty()) { return false; }
+
+	PCGExZoneShapeBake::FShapesView Packed;
+	if (!Packed.Parse(PackedShapes.GetData(), PackedShapes.Num()))
+	{
+		UE_LOG(LogPCGExZoneGraph, Warning, TEXT("Invalid packed zone shapes on '%s'."), *GetPathName());
+		return false;
+	}
+
+	PCGExZoneShapeBake::WriteLanes(Packed, this, OutWriter);
+	return true;
+}
@@ -9,6 +9,8 @@
 
 #define LOCTEXT_NAMESPACE "FPCGExElementsZoneGraphModule"
 
+DEFINE_LOG_CATEGORY(LogPCGExZoneGraph);
+
 void FPCGExElementsZoneGraphModule::StartupModule()
 {
 	OldBaseModules.Add(TEXT("PCGExtendedToolkitZoneGraph"));
@@ -0,0 +1,483 @@
+﻿// Copyright 2025 Timothé Lapetite and contributors
+// Released under the MIT license https://opensource.org/license/MIT/
+
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include <type_traits>
+#include "Graph/PCGExClusterToZoneGraphKernels.h"
+
+namespace PCGExClusterToZoneGraphTests
+{
+	/** Stand-in for a chain link, the vote only reads the edge index. */
+	struct FTestLink
+	{
+		int32 Node = -1;
+		int32 Edge = -1;
+	};
+
+	struct FTestRoad
+	{
+		TArray<FVector> Positions;
+		TArray<FTestLink> Links;
+		bool bClosedLoop = false;
+	};
+
+	/** A handful of open and closed roads spread across a few lane profile buckets. */
+	void MakeTestRoads(TArray<FTestRoad>& OutRoads, TArray<int32>& OutEdgeBuckets, int32& OutNumBuckets)
+	{
+		OutNumBuckets = 3;
+
+		FRandomStream Random(1337);
+		for (int32 r = 0; r < 16; r++)
+		{
+			FTestRoad& Road = OutRoads.Emplace_GetRef();
+			Road.bClosedLoop = (r % 4) == 3;
+
+			const int32 NumPoints = 2 + (r * 7) % 23;
+			for (int32 i = 0; i < NumPoints; i++)
+			{
+				const double Angle = UE_TWO_PI * i / NumPoints;
+				Road.Positions.Add(Road.bClosedLoop
+					                   ? FVector(FMath::Cos(Angle), FMath::Sin(Angle), 0) * 1000 + FVector(r * 5000, 0, 0)
+					                   : FVector(i * 250.0, Random.FRandRange(-50, 50), Random.FRandRange(-10, 10)) + FVector(0, r * 5000, 0));
+
+				FTestLink& Link = Road.Links.Emplace_GetRef();
+				Link.Node = OutEdgeBuckets.Num();
+				Link.Edge = i == 0 && !Road.bClosedLoop ? -1 : OutEdgeBuckets.Num();
+				OutEdgeBuckets.Add(Random.RandRange(0, OutNumBuckets - 1));
+			}
+		}
+	}
+
+	/** Node accessor standing in for a cluster, one node per test road point. */
+	struct FTestCluster
+	{
+		TArray<FVector> Positions;
+		TArray<bool> Leaves;
+
+		FVector GetPos(const int32 Node) const { return Positions[Node]; }
+		int32 GetPointIndex(const int32 Node) const { return Node; }
+		bool IsLeaf(const int32 Node) const { return Leaves[Node]; }
+	};
+
+	/** Lays the test roads out as a cluster and matching road records over a shared staging buffer.
+	 * Every other open road starts on a leaf, the other ends sit on a polygon and get trimmed. */
+	void MakeTestCluster(const TArray<FTestRoad>& Roads, FTestCluster& OutCluster, TArray<PCGExClusterToZoneGraph::FZGRoad>& OutRecords, PCGExClusterToZoneGraph::FShapePointBuffer& OutStaging)
+	{
+		using namespace PCGExClusterToZoneGraph;
+
+		int32 NumPoints = 0;
+		for (int32 r = 0; r < Roads.Num(); r++)
+		{
+			const FTestRoad& Road = Roads[r];
+			const int32 Num = Road.Positions.Num();
+
+			OutCluster.Positions.SetNum(FMath::Max(OutCluster.Positions.Num(), Road.Links.Last().Node + 1));
+			OutCluster.Leaves.SetNum(OutCluster.Positions.Num());
+			for (int32 i = 0; i < Num; i++)
+			{
+				OutCluster.Positions[Road.Links[i].Node] = Road.Positions[i];
+				OutCluster.Leaves[Road.Links[i].Node] = !Road.bClosedLoop && i == 0 && r % 2 == 0;
+			}
+
+			FZGRoad& Record = OutRecords.Emplace_GetRef(nullptr, nullptr, false);
+			Record.PointOffset = NumPoints;
+			Record.PointCapacity = Num + 1;
+			NumPoints += Record.PointCapacity;
+
+			if (Road.bClosedLoop) { continue; }
+
+			auto MakeEndpoint = [](const FVector& Center, const FVector& Toward)
+			{
+				FZGRoad::FPolygonEndpoint Endpoint;
+				Endpoint.PolygonCenter = Center;
+				Endpoint.Direction = (Toward - Center).GetSafeNormal();
+				Endpoint.Radius = 100;
+				Endpoint.bValid = true;
+				return Endpoint;
+			};
+
+			if (r % 2 != 0) { Record.StartEndpoint = MakeEndpoint(Road.Positions[0], Road.Positions[Num - 1]); }
+			Record.EndEndpoint = MakeEndpoint(Road.Positions[Num - 1], Road.Positions[0]);
+		}
+
+		OutStaging.SetNum(NumPoints);
+	}
+
+	/** One precompute scope over every test road: lane profile vote, then the trimmed Auto tangent road kernel. */
+	void RunPrecomputePass(const TArray<FTestRoad>& Roads, const TArray<int32>& EdgeBuckets, const int32 NumBuckets, const FTestCluster& Cluster, TArray<PCGExClusterToZoneGraph::FZGRoad>& Records, const PCGExClusterToZoneGraph::FRoadPrecomputeParams& Params, PCGExClusterToZoneGraph::FPrecomputeScratch& Scratch)
+	{
+		using namespace PCGExClusterToZoneGraph;
+
+		for (int32 r = 0; r < Roads.Num(); r++)
+		{
+			const FTestRoad& Road = Roads[r];
+			FZGRoad& Record = Records[r];
+
+			Record.bDegenerate = false;
+			Record.LaneProfileIndex = Kernels::VoteLaneProfile(Road.Links, EdgeBuckets, NumBuckets, Scratch);
+
+			// The chain lists its nodes into scratch ahead of the kernel
+			Scratch.Nodes.Reset();
+			for (const FTestLink& Link : Road.Links) { Scratch.Nodes.Add(Link.Node); }
+
+			if (Road.bClosedLoop) { Record.PrecomputeNodes<false, ERoadTangentKernel::Auto, true, true>(Cluster, Params, Scratch); }
+			else { Record.PrecomputeNodes<false, ERoadTangentKernel::Auto, true, false>(Cluster, Params, Scratch); }
+		}
+	}
+
+	/** Scalar reference of the chord direction pass, as it ran before the SIMD kernels. */
+	void ReferenceChordForwards(const TArray<FVector>& Positions, TArray<FVector>& OutForwards, const bool bLoop)
+	{
+		const int32 Num = Positions.Num();
+		OutForwards.SetNum(Num);
+
+		auto Blend = [](const FVector& DirPrev, const FVector& DirNext)
+		{
+			const FVector Forward = (DirPrev + DirNext).GetSafeNormal();
+			return Forward.IsNearlyZero() ? DirNext : Forward;
+		};
+
+		const FVector WrapDir = (Positions[0] - Positions[Num - 1]).GetSafeNormal();
+		for (int32 i = 0; i < Num; i++)
+		{
+			const FVector DirPrev = i > 0 ? (Positions[i] - Positions[i - 1]).GetSafeNormal() : WrapDir;
+			const FVector DirNext = i < Num - 1 ? (Positions[i + 1] - Positions[i]).GetSafeNormal() : WrapDir;
+			if (bLoop) { OutForwards[i] = Blend(DirPrev, DirNext); }
+			else { OutForwards[i] = i == 0 ? DirNext : i == Num - 1 ? DirPrev : Blend(DirPrev, DirNext); }
+		}
+	}
+
+	/** Scalar reference of the Auto/CatmullRom tangent pass. */
+	void ReferenceSmoothTangents(const TArray<FVector>& Positions, TArray<FVector>& InOutForwards, TArray<float>& OutLengths, const bool bLoop, const bool bCatmullRom, const double Scale)
+	{
+		const int32 Num = Positions.Num();
+		OutLengths.SetNum(Num);
+
+		for (int32 i = 0; i < Num; i++)
+		{
+			const FVector& Current = Positions[i];
+			const FVector Prev = i > 0 ? Positions[i - 1] : bLoop ? Positions[Num - 1] : Current - (Positions[1] - Current);
+			const FVector Next = i < Num - 1 ? Positions[i + 1] : bLoop ? Positions[0] : Current + (Current - Positions[Num - 2]);
+
+			const FVector TangentDir = (Next - Prev).GetSafeNormal();
+			if (!TangentDir.IsNearlyZero()) { InOutForwards[i] = TangentDir; }
+
+			OutLengths[i] = bCatmullRom
+				                ? FVector::Dist(Prev, Next) / 6.0 * Scale
+				                : (FVector::Dist(Current, Prev) + FVector::Dist(Current, Next)) * 0.5 / 3.0 * Scale;
+		}
+	}
+
+	/** Untrimmed roads of a large synthetic network, every open end on a leaf. */
+	struct FBenchmarkRoads
+	{
+		FTestCluster Cluster;
+		TArray<TArray<int32>> Chains;
+		TArray<bool> Loops;
+		TArray<PCGExClusterToZoneGraph::FZGRoad> Records;
+		PCGExClusterToZoneGraph::FShapePointBuffer Staging;
+		int32 MaxPoints = 0;
+
+		void Build(const int32 NumRoads, const int32 Seed)
+		{
+			FRandomStream Random(Seed);
+			int32 NumPoints = 0;
+			for (int32 r = 0; r < NumRoads; r++)
+			{
+				const int32 Num = Random.RandRange(2, 48);
+				MaxPoints = FMath::Max(MaxPoints, Num);
+
+				TArray<int32>& Chain = Chains.Emplace_GetRef();
+				Loops.Add(Num > 8 && Random.FRand() < 0.1f);
+
+				FVector Position = Random.VRand() * 1e6;
+				for (int32 i = 0; i < Num; i++)
+				{
+					Chain.Add(Cluster.Positions.Num());
+					Position += FVector(Random.FRandRange(100, 400), Random.FRandRange(-150, 150), Random.FRandRange(-20, 20));
+					Cluster.Positions.Add(Position);
+					Cluster.Leaves.Add(true);
+				}
+
+				PCGExClusterToZoneGraph::FZGRoad& Record = Records.Emplace_GetRef(nullptr, nullptr, false);
+				Record.PointOffset = NumPoints;
+				Record.PointCapacity = Num + 1;
+				NumPoints += Record.PointCapacity;
+			}
+
+			Staging.SetNum(NumPoints);
+		}
+	};
+
+	/** Tangent length source of the generic reference, read per point through a virtual call like a setting value. */
+	struct FTestTangentSource
+	{
+		double Length = 0;
+
+		virtual ~FTestTangentSource() = default;
+		virtual double Read(const int32 Index) const { return Length; }
+	};
+
+	/** Road precompute with settings re-checked for every point, as it ran before the kernels were specialized.
+	 * Covers untrimmed roads, which is all the benchmark feeds it. */
+	void RunGenericPrecompute(const FTestCluster& Cluster, const TArray<int32>& Nodes, const bool bClosedLoop, const EPCGExZGTangentLengthMode Mode, const FTestTangentSource& TangentSource, const PCGExClusterToZoneGraph::FRoadPrecomputeParams& Params, PCGExClusterToZoneGraph::FZGRoad& Road, PCGExClusterToZoneGraph::FPrecomputeScratch& Scratch)
+	{
+		using namespace PCGExClusterToZoneGraph;
+
+		FShapePointBuffer& Staging = *Params.Staging;
+		FVector* Positions = Staging.Positions.GetData() + Road.PointOffset;
+		FVector* Forwards = Staging.Forwards.GetData() + Road.PointOffset;
+		float* TangentLengths = Staging.TangentLengths.GetData() + Road.PointOffset;
+		FZoneShapePointType* Types = Staging.Types.GetData() + Road.PointOffset;
+
+		const int32 Num = Nodes.Num();
+		Road.NumPoints = Num;
+
+		for (int32 i = 0; i < Num; i++)
+		{
+			const int32 PointIndex = Cluster.GetPointIndex(Nodes[i]);
+			Positions[i] = Cluster.GetPos(Nodes[i]);
+			Types[i] = Params.PointTypeBuffer ? static_cast<FZoneShapePointType>(FMath::Clamp(Params.PointTypeBuffer->Read(PointIndex), 0, 3)) : Params.PointType;
+
+			switch (Mode)
+			{
+			case EPCGExZGTangentLengthMode::Manual:
+				TangentLengths[i] = TangentSource.Read(PointIndex) * Params.TangentLengthScale;
+				break;
+			default:
+				TangentLengths[i] = 0;
+				break;
+			}
+		}
+
+		Kernels::ComputeChordForwards(Positions, Forwards, Num, bClosedLoop, Scratch);
+
+		if (Mode == EPCGExZGTangentLengthMode::Auto || Mode == EPCGExZGTangentLengthMode::CatmullRom)
+		{
+			if (Mode == EPCGExZGTangentLengthMode::CatmullRom) { Kernels::ComputeSmoothTangents<double, true>(Positions, Forwards, TangentLengths, Num, bClosedLoop, Params.TangentLengthScale, Scratch); }
+			else { Kernels::ComputeSmoothTangents<double, false>(Positions, Forwards, TangentLengths, Num, bClosedLoop, Params.TangentLengthScale, Scratch); }
+		}
+
+		Kernels::BuildRotations(Forwards, Staging.Rotations.GetData() + Road.PointOffset, Num);
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FPCGExZoneGraphPrecomputeAllocationsTest, "PCGEx.ZoneGraph.Precompute.SteadyStateAllocations", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FPCGExZoneGraphPrecomputeAllocationsTest::RunTest(const FString& Parameters)
+{
+	using namespace PCGExClusterToZoneGraph;
+	using namespace PCGExClusterToZoneGraphTests;
+
+	TArray<FTestRoad> Roads;
+	TArray<int32> EdgeBuckets;
+	int32 NumBuckets = 0;
+	MakeTestRoads(Roads, EdgeBuckets, NumBuckets);
+
+	FTestCluster Cluster;
+	TArray<FZGRoad> Records;
+	FShapePointBuffer Staging;
+	MakeTestCluster(Roads, Cluster, Records, Staging);
+
+	FRoadPrecomputeParams Params;
+	Params.Staging = &Staging;
+	Params.EndpointTrimBuffer = 50;
+
+	int32 MaxPoints = 0;
+	for (const FTestRoad& Road : Roads) { MaxPoints = FMath::Max(MaxPoints, Road.Positions.Num()); }
+
+	// Staging is processor-owned and sized up front, node scratch is reserved once per scope
+	FPrecomputeScratch Scratch;
+	Scratch.Nodes.Reserve(MaxPoints + 1);
+
+	// First pass sizes the vote histogram, the seen list and the kernel lanes
+	RunPrecomputePass(Roads, EdgeBuckets, NumBuckets, Cluster, Records, Params, Scratch);
+
+	const uint32 AllocationsBefore = FScratchAllocator::GetThreadAllocations();
+	RunPrecomputePass(Roads, EdgeBuckets, NumBuckets, Cluster, Records, Params, Scratch);
+	const int32 NumAllocations = static_cast<int32>(FScratchAllocator::GetThreadAllocations() - AllocationsBefore);
+
+	TestEqual(TEXT("Scratch allocations during a steady-state precompute pass"), NumAllocations, 0);
+
+	int32 NumTrimmed = 0;
+	for (int32 r = 0; r < Roads.Num(); r++)
+	{
+		const FZGRoad& Record = Records[r];
+		if (Record.bDegenerate) { continue; }
+
+		TestTrue(TEXT("Precomputed roads keep at least two points"), Record.NumPoints >= 2);
+		if (Record.EndEndpoint.bValid)
+		{
+			// Trimmed ends snap to the polygon connector
+			const FVector Connector = Record.EndEndpoint.PolygonCenter + Record.EndEndpoint.Direction * Record.EndEndpoint.Radius;
+			TestTrue(TEXT("Trimmed road ends on its polygon connector"), Staging.Positions[Record.PointOffset + Record.NumPoints - 1].Equals(Connector, 1e-6));
+			NumTrimmed++;
+		}
+
+		for (int32 i = 0; i < Record.NumPoints; i++)
+		{
+			const int32 Index = Record.PointOffset + i;
+			TestTrue(TEXT("Staged rotation follows the staged forward"), Staging.Rotations[Index].Equals(Kernels::MakeShapeRotation(Staging.Forwards[Index]), 1e-3));
+		}
+	}
+
+	TestTrue(TEXT("Roads ending on a polygon went through trimming"), NumTrimmed > 0);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FPCGExZoneGraphKernelParityTest, "PCGEx.ZoneGraph.Precompute.KernelParity", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FPCGExZoneGraphKernelParityTest::RunTest(const FString& Parameters)
+{
+	using namespace PCGExClusterToZoneGraph;
+	using namespace PCGExClusterToZoneGraphTests;
+
+	TArray<FTestRoad> Roads;
+	TArray<int32> EdgeBuckets;
+	int32 NumBuckets = 0;
+	MakeTestRoads(Roads, EdgeBuckets, NumBuckets);
+
+	// Far from the world origin, single precision would lose the fraction without a local origin
+	FTestRoad& FarRoad = Roads.Emplace_GetRef();
+	for (int32 i = 0; i < 12; i++) { FarRoad.Positions.Add(FVector(2.0e7 + i * 3.25, 1.5e7 + FMath::Sin(i * 0.5) * 2.0, 100.0)); }
+
+	FPrecomputeScratch Scratch;
+	TArray<FVector> Forwards;
+	TArray<FVector> ForwardsSingle;
+	TArray<FVector> Expected;
+	TArray<float> Lengths;
+	TArray<float> LengthsSingle;
+	TArray<float> ExpectedLengths;
+	TArray<FRotator> Rotations;
+
+	for (const FTestRoad& Road : Roads)
+	{
+		const int32 Num = Road.Positions.Num();
+		const FVector* Positions = Road.Positions.GetData();
+
+		Forwards.SetNumUninitialized(Num);
+		Lengths.SetNumUninitialized(Num);
+		LengthsSingle.SetNumUninitialized(Num);
+		Rotations.SetNumUninitialized(Num);
+
+		for (const bool bCatmullRom : {false, true})
+		{
+			ReferenceChordForwards(Road.Positions, Expected, Road.bClosedLoop);
+			Kernels::ComputeChordForwards(Positions, Forwards.GetData(), Num, Road.bClosedLoop, Scratch);
+			for (int32 i = 0; i < Num; i++) { TestTrue(TEXT("Chord forward matches the scalar reference"), Forwards[i].Equals(Expected[i], 1e-9)); }
+
+			ForwardsSingle = Forwards;
+			ReferenceSmoothTangents(Road.Positions, Expected, ExpectedLengths, Road.bClosedLoop, bCatmullRom, 1.5);
+
+			if (bCatmullRom)
+			{
+				Kernels::ComputeSmoothTangents<double, true>(Positions, Forwards.GetData(), Lengths.GetData(), Num, Road.bClosedLoop, 1.5, Scratch);
+				Kernels::ComputeSmoothTangents<float, true>(Positions, ForwardsSingle.GetData(), LengthsSingle.GetData(), Num, Road.bClosedLoop, 1.5, Scratch);
+			}
+			else
+			{
+				Kernels::ComputeSmoothTangents<double, false>(Positions, Forwards.GetData(), Lengths.GetData(), Num, Road.bClosedLoop, 1.5, Scratch);
+				Kernels::ComputeSmoothTangents<float, false>(Positions, ForwardsSingle.GetData(), LengthsSingle.GetData(), Num, Road.bClosedLoop, 1.5, Scratch);
+			}
+
+			for (int32 i = 0; i < Num; i++)
+			{
+				TestTrue(TEXT("Tangent direction matches the scalar reference"), Forwards[i].Equals(Expected[i], 1e-9));
+				TestTrue(TEXT("Tangent length matches the scalar reference"), FMath::IsNearlyEqual(Lengths[i], ExpectedLengths[i], 1e-3f));
+				TestTrue(TEXT("Single precision tangent direction stays close"), ForwardsSingle[i].Equals(Expected[i], 1e-3));
+				TestTrue(TEXT("Single precision tangent length stays close"), FMath::IsNearlyEqual(LengthsSingle[i], ExpectedLengths[i], FMath::Max(1e-2f, ExpectedLengths[i] * 1e-4f)));
+			}
+
+			Kernels::BuildRotations(Forwards.GetData(), Rotations.GetData(), Num);
+			for (int32 i = 0; i < Num; i++)
+			{
+				FZoneShapePoint Point;
+				Point.SetRotationFromForwardAndUp(Forwards[i], FVector::UpVector);
+				TestTrue(TEXT("Staged rotation matches the shape point rotation"), Rotations[i].Equals(Point.Rotation, 1e-3));
+			}
+		}
+	}
+
+	// Vertical and zero forwards go through the shape point's own up axis switch
+	const TArray<FVector> Vertical = {FVector::UpVector, FVector::DownVector, FVector(1e-4, 0, 1).GetSafeNormal(), FVector::ZeroVector, FVector(0, -1, 0.5).GetSafeNormal()};
+	Rotations.SetNumUninitialized(Vertical.Num());
+	Kernels::BuildRotations(Vertical.GetData(), Rotations.GetData(), Vertical.Num());
+	for (int32 i = 0; i < Vertical.Num(); i++)
+	{
+		FZoneShapePoint Point;
+		Point.SetRotationFromForwardAndUp(Vertical[i], FVector::UpVector);
+		TestTrue(TEXT("Vertical forward rotation matches the shape point rotation"), Rotations[i].Equals(Point.Rotation, 1e-3));
+	}
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FPCGExZoneGraphKernelSpecializationTest, "PCGEx.ZoneGraph.Precompute.KernelSpecialization", EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter)
+
+bool FPCGExZoneGraphKernelSpecializationTest::RunTest(const FString& Parameters)
+{
+	using namespace PCGExClusterToZoneGraph;
+	using namespace PCGExClusterToZoneGraphTests;
+
+	FBenchmarkRoads Roads;
+	Roads.Build(50000, 7);
+
+	FRoadPrecomputeParams Params;
+	Params.Staging = &Roads.Staging;
+	Params.TangentLengthScale = 1.25;
+	Params.ConstantTangentLength = 150 * Params.TangentLengthScale;
+
+	FTestTangentSource TangentSource;
+	TangentSource.Length = 150;
+
+	FPrecomputeScratch Scratch;
+	Scratch.Nodes.Reserve(Roads.MaxPoints + 1);
+
+	auto Measure = [&](auto&& Pass)
+	{
+		double Best = MAX_dbl;
+		for (int32 Run = 0; Run < 3; Run++)
+		{
+			const double Start = FPlatformTime::Seconds();
+			for (int32 r = 0; r < Roads.Chains.Num(); r++) { Pass(r); }
+			Best = FMath::Min(Best, FPlatformTime::Seconds() - Start);
+		}
+		return Best;
+	};
+
+	auto MeasureMode = [&](auto Kernel, const EPCGExZGTangentLengthMode Mode, const TCHAR* Name)
+	{
+		constexpr ERoadTangentKernel TangentKernel = decltype(Kernel)::value;
+
+		const double Generic = Measure(
+			[&](const int32 r)
+			{
+				RunGenericPrecompute(Roads.Cluster, Roads.Chains[r], Roads.Loops[r], Mode, TangentSource, Params, Roads.Records[r], Scratch);
+			});
+
+		const double Specialized = Measure(
+			[&](const int32 r)
+			{
+				Scratch.Nodes.Reset();
+				Scratch.Nodes.Append(Roads.Chains[r]);
+
+				FZGRoad& Record = Roads.Records[r];
+				if (Roads.Loops[r]) { Record.PrecomputeNodes<false, TangentKernel, false, true>(Roads.Cluster, Params, Scratch); }
+				else { Record.PrecomputeNodes<false, TangentKernel, false, false>(Roads.Cluster, Params, Scratch); }
+			});
+
+		// Reported rather than asserted, timings depend on the machine
+		AddInfo(FString::Printf(TEXT("%s tangents over %d roads: %.2fms generic, %.2fms specialized, %.2fx."), Name, Roads.Chains.Num(), Generic * 1000, Specialized * 1000, Generic / Specialized));
+	};
+
+	MeasureMode(std::integral_constant<ERoadTangentKernel, ERoadTangentKernel::ManualConstant>(), EPCGExZGTangentLengthMode::Manual, TEXT("Constant manual"));
+	MeasureMode(std::integral_constant<ERoadTangentKernel, ERoadTangentKernel::Auto>(), EPCGExZGTangentLengthMode::Auto, TEXT("Auto"));
+	MeasureMode(std::integral_constant<ERoadTangentKernel, ERoadTangentKernel::CatmullRom>(), EPCGExZGTangentLengthMode::CatmullRom, TEXT("Catmull-Rom"));
+
+	return true;
+}
+
+#endif
@@ -0,0 +1,190 @@
+﻿// Copyright 2025 Timothé Lapetite and contributors
+// Released under the MIT license https://opensource.org/license/MIT/
+
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "Async/ParallelFor.h"
+#include "Async/TaskGraphInterfaces.h"
+#include "HAL/PlatformTime.h"
+#include "Math/RandomStream.h"
+#include "Graph/PCGExClusterToZoneGraph.h"
+
+namespace PCGExClusterToZoneGraphTilingTests
+{
+	struct FTestChain
+	{
+		int32 Start = -1;
+		int32 End = -1;
+		bool bRoamingLoop = false;
+	};
+
+	/** Chain ends laid out the way connectors are: one range per node, each entry a road and the end it sits at. */
+	struct FTestGraph
+	{
+		int32 NumNodes = 0;
+		TArray<FTestChain> Chains;
+		TArray<int32> EndStarts;
+		TArray<TPair<int32, bool>> Ends;
+
+		void Build(const int32 InNumNodes, const int32 InNumChains, const int32 InSeed)
+		{
+			NumNodes = InNumNodes;
+
+			FRandomStream Random(InSeed);
+			Chains.SetNum(InNumChains);
+			for (FTestChain& Chain : Chains)
+			{
+				Chain.Start = Random.RandHelper(NumNodes);
+				Chain.End = Random.RandHelper(NumNodes);
+				Chain.bRoamingLoop = Random.FRand() < 0.02f;
+			}
+
+			EndStarts.Init(0, NumNodes + 1);
+			for (const FTestChain& Chain : Chains)
+			{
+				EndStarts[Chain.Start + 1]++;
+				EndStarts[Chain.End + 1]++;
+			}
+			for (int32 i = 0; i < NumNodes; i++) { EndStarts[i + 1] += EndStarts[i]; }
+
+			TArray<int32> Cursors(EndStarts.GetData(), NumNodes);
+			Ends.SetNumUninitialized(EndStarts[NumNodes]);
+			for (int32 c = 0; c < Chains.Num(); c++)
+			{
+				Ends[Cursors[Chains[c].Start]++] = TPair<int32, bool>(c, true);
+				Ends[Cursors[Chains[c].End]++] = TPair<int32, bool>(c, false);
+			}
+		}
+
+		/** Single chain ends stand in for leaves, which never get a polygon. */
+		bool IsLeaf(const int32 Node) const { return EndStarts[Node + 1] - EndStarts[Node] <= 1; }
+
+		/** Slots handed out by the first road reaching each node, start before end, as the untiled path does. */
+		void GetUntiledSlots(TArray<int32>& OutSlots) const
+		{
+			OutSlots.Init(-1, NumNodes);
+			int32 NumPolygons = 0;
+			for (const FTestChain& Chain : Chains)
+			{
+				if (Chain.bRoamingLoop) { continue; }
+				for (const int32 Node : {Chain.Start, Chain.End})
+				{
+					if (!IsLeaf(Node) && OutSlots[Node] == -1) { OutSlots[Node] = NumPolygons++; }
+				}
+			}
+		}
+
+		int32 GetOrderKey(const int32 Node) const
+		{
+			if (IsLeaf(Node)) { return -1; }
+
+			int32 Key = MAX_int32;
+			for (int32 e = EndStarts[Node]; e < EndStarts[Node + 1]; e++)
+			{
+				if (!Chains[Ends[e].Key].bRoamingLoop) { Key = FMath::Min(Key, PCGExClusterToZoneGraph::GetPolygonOrderKey(Ends[e].Key, Ends[e].Value)); }
+			}
+			return Key == MAX_int32 ? -1 : Key;
+		}
+
+		/** Tiled slots: polygons keyed per tile concurrently, laid out tile after tile, then ranked back into order. */
+		void GetTiledSlots(const int32 NumTiles, const EParallelForFlags Flags, TArray<int32>& OutSlots) const
+		{
+			// Tiles are interleaved node ranges, so tile order and node order disagree
+			TArray<TArray<TPair<int32, int32>>> TileKeys;
+			TileKeys.SetNum(NumTiles);
+
+			ParallelFor(
+				NumTiles, [&](const int32 Tile)
+				{
+					for (int32 Node = Tile; Node < NumNodes; Node += NumTiles)
+					{
+						const int32 Key = GetOrderKey(Node);
+						if (Key != -1) { TileKeys[Tile].Emplace(Node, Key); }
+					}
+				}, Flags);
+
+			TArray<int32> Nodes;
+			TArray<int32> Keys;
+			for (const TArray<TPair<int32, int32>>& Tile : TileKeys)
+			{
+				for (const TPair<int32, int32>& Entry : Tile)
+				{
+					Nodes.Add(Entry.Key);
+					Keys.Add(Entry.Value);
+				}
+			}
+
+			TArray<int32> Ranked;
+			PCGExClusterToZoneGraph::RankPolygonOrderKeys(Keys, Chains.Num() * 2, Ranked);
+
+			OutSlots.Init(-1, NumNodes);
+			for (int32 i = 0; i < Nodes.Num(); i++) { OutSlots[Nodes[i]] = Ranked[i]; }
+		}
+	};
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FPCGExZoneGraphTiledOrderTest, "PCGEx.ZoneGraph.Tiling.MatchesUntiled", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FPCGExZoneGraphTiledOrderTest::RunTest(const FString& Parameters)
+{
+	using namespace PCGExClusterToZoneGraphTilingTests;
+
+	FTestGraph Graph;
+	Graph.Build(2000, 3000, 1337);
+
+	TArray<int32> Untiled;
+	Graph.GetUntiledSlots(Untiled);
+
+	// Slot order must not depend on the tile count
+	for (const int32 NumTiles : {1, 7, 64})
+	{
+		TArray<int32> Tiled;
+		Graph.GetTiledSlots(NumTiles, EParallelForFlags::None, Tiled);
+
+		int32 NumMismatches = 0;
+		for (int32 Node = 0; Node < Graph.NumNodes; Node++) { if (Tiled[Node] != Untiled[Node]) { NumMismatches++; } }
+		TestEqual(*FString::Printf(TEXT("Polygon slots differing from the untiled order with %d tiles"), NumTiles), NumMismatches, 0);
+	}
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FPCGExZoneGraphTiledScalingTest, "PCGEx.ZoneGraph.Tiling.Scaling", EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter)
+
+bool FPCGExZoneGraphTiledScalingTest::RunTest(const FString& Parameters)
+{
+	using namespace PCGExClusterToZoneGraphTilingTests;
+
+	// Roughly the node and chain counts of a 2M-edge road network
+	FTestGraph Graph;
+	Graph.Build(1000000, 1200000, 7);
+
+	constexpr int32 NumTiles = 256;
+	auto Measure = [&](const EParallelForFlags Flags)
+	{
+		TArray<int32> Slots;
+		double Best = MAX_dbl;
+		for (int32 Run = 0; Run < 3; Run++)
+		{
+			const double Start = FPlatformTime::Seconds();
+			Graph.GetTiledSlots(NumTiles, Flags, Slots);
+			Best = FMath::Min(Best, FPlatformTime::Seconds() - Start);
+		}
+		return Best;
+	};
+
+	const double Serial = Measure(EParallelForFlags::ForceSingleThread);
+	const double Parallel = Measure(EParallelForFlags::None);
+	const int32 NumWorkers = FTaskGraphInterface::Get().GetNumWorkerThreads() + 1;
+
+	// Reported rather than asserted, timings depend on the machine
+	AddInfo(FString::Printf(
+		TEXT("Tiled polygon keying and ordering over %d tiles: %.2fms serial, %.2fms on %d threads, %.2fx speedup (%.0f%% efficiency)."),
+		NumTiles, Serial * 1000, Parallel * 1000, NumWorkers, Serial / Parallel, Serial / Parallel / NumWorkers * 100));
+
+	return true;
+}
+
+#endif
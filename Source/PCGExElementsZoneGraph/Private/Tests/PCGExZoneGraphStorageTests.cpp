@@ -0,0 +1,156 @@
+﻿// Copyright 2025 Timothé Lapetite and contributors
+// Released under the MIT license https://opensource.org/license/MIT/
+
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS && WITH_EDITOR
+
+#include "ZoneGraphBuilder.h"
+#include "ZoneGraphData.h"
+#include "ZoneGraphSettings.h"
+#include "ZoneShapeComponent.h"
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+#include "Graph/PCGExZoneGraphStorage.h"
+
+namespace PCGExZoneGraphStorageTests
+{
+	/** Index-free description of every lane and its links, so storages built in a different shape order compare equal. */
+	void DescribeLanes(const FZoneGraphStorage& Storage, TArray<FString>& OutLanes)
+	{
+		auto DescribeLane = [&](const int32 LaneIndex)
+		{
+			const FZoneLaneData& Lane = Storage.Lanes[LaneIndex];
+			return FString::Printf(
+				TEXT("%s>%s w%.0f"),
+				*Storage.LanePoints[Lane.PointsBegin].GridSnap(1).ToCompactString(),
+				*Storage.LanePoints[Lane.PointsEnd - 1].GridSnap(1).ToCompactString(),
+				Lane.Width);
+		};
+
+		OutLanes.Reset();
+		for (int32 i = 0; i < Storage.Lanes.Num(); i++)
+		{
+			const FZoneLaneData& Lane = Storage.Lanes[i];
+
+			TArray<FString> LaneLinks;
+			for (int32 l = Lane.LinksBegin; l < Lane.LinksEnd; l++)
+			{
+				const FZoneLaneLinkData& Link = Storage.LaneLinks[l];
+				LaneLinks.Add(FString::Printf(TEXT("%d/%d %s"), static_cast<int32>(Link.Type), static_cast<int32>(Link.GetFlags()), *DescribeLane(Link.DestLaneIndex)));
+			}
+
+			LaneLinks.Sort();
+			OutLanes.Add(DescribeLane(i) + TEXT(" [") + FString::Join(LaneLinks, TEXT(", ")) + TEXT("]"));
+		}
+
+		OutLanes.Sort();
+	}
+
+	FZoneShapePoint MakePoint(const FVector& Position, const double Yaw, const FZoneShapePointType Type)
+	{
+		FZoneShapePoint Point(Position);
+		Point.Rotation = FRotator(0, Yaw, 0);
+		Point.Type = Type;
+		return Point;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FPCGExZoneGraphStorageParityTest, "PCGEx.ZoneGraph.Storage.MatchesBuilder", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FPCGExZoneGraphStorageParityTest::RunTest(const FString& Parameters)
+{
+	using namespace PCGExZoneGraphStorageTests;
+
+	const TArray<FZoneLaneProfile>& Profiles = GetDefault<UZoneGraphSettings>()->GetLaneProfiles();
+	if (Profiles.IsEmpty())
+	{
+		AddWarning(TEXT("No lane profile in the ZoneGraph settings, skipped."));
+		return true;
+	}
+
+	const FZoneLaneProfile& Profile = Profiles[0];
+	const FZoneGraphTagMask Tags = GetDefault<UZoneShapeComponent>()->GetTags();
+
+	// A three-way intersection: a polygon with one lane profile point per road, each pointing into the polygon
+	const TArray<FZoneShapePoint> PolygonPoints = {
+		MakePoint(FVector(-200, 0, 0), 0, FZoneShapePointType::LaneProfile),
+		MakePoint(FVector(200, 0, 0), 180, FZoneShapePointType::LaneProfile),
+		MakePoint(FVector(0, 200, 0), -90, FZoneShapePointType::LaneProfile)};
+
+	const TArray<TArray<FZoneShapePoint>> Roads = {
+		{MakePoint(FVector(-1000, 0, 0), 0, FZoneShapePointType::Sharp), MakePoint(FVector(-200, 0, 0), 0, FZoneShapePointType::Sharp)},
+		{MakePoint(FVector(200, 0, 0), 0, FZoneShapePointType::Sharp), MakePoint(FVector(1000, 0, 0), 0, FZoneShapePointType::Sharp)},
+		{MakePoint(FVector(0, 200, 0), 90, FZoneShapePointType::Sharp), MakePoint(FVector(0, 1000, 0), 90, FZoneShapePointType::Sharp)}};
+
+	UWorld* World = UWorld::CreateWorld(EWorldType::Editor, false, TEXT("PCGExZoneGraphStorageParity"));
+	AActor* Actor = World->SpawnActor<AActor>();
+	USceneComponent* Root = NewObject<USceneComponent>(Actor);
+	Actor->SetRootComponent(Root);
+	Root->RegisterComponent();
+
+	// Reference lanes from shape components, through the ZoneGraph builder
+	TArray<UZoneShapeComponent*> Shapes;
+	auto AddShape = [&](const TArray<FZoneShapePoint>& InPoints, const bool bPolygon)
+	{
+		UZoneShapeComponent* Shape = NewObject<UZoneShapeComponent>(Actor);
+		Shape->SetShapeType(bPolygon ? FZoneShapeType::Polygon : FZoneShapeType::Spline);
+		if (bPolygon) { Shape->SetPolygonRoutingType(EZoneShapePolygonRoutingType::Arcs); }
+		Shape->SetCommonLaneProfile(FZoneLaneProfileRef(Profile));
+		Shape->GetMutablePoints() = InPoints;
+		Shape->SetupAttachment(Root);
+		Shape->RegisterComponent();
+		Shape->UpdateShape();
+		Shapes.Add(Shape);
+	};
+
+	AddShape(PolygonPoints, true);
+	for (const TArray<FZoneShapePoint>& Road : Roads) { AddShape(Road, false); }
+
+	AZoneGraphData* Reference = World->SpawnActor<AZoneGraphData>();
+	FZoneGraphBuilder Builder;
+	for (UZoneShapeComponent* Shape : Shapes) { Builder.RegisterZoneShapeComponent(*Shape); }
+	Builder.BuildAll({Reference}, true);
+
+	// Same shapes written straight to storage, the way clusters are emitted
+	PCGExZoneGraphStorage::FChunk Chunk;
+	TArray<FZoneLaneProfile> PointProfiles;
+	PointProfiles.Init(Profile, PolygonPoints.Num());
+
+	const int32 PolygonZone = Chunk.AddPolygon(PolygonPoints, EZoneShapePolygonRoutingType::Arcs, PointProfiles, Tags);
+	for (const TArray<FZoneShapePoint>& Road : Roads)
+	{
+		const int32 RoadZone = Chunk.AddSpline(Road, Profile, Tags);
+		if (RoadZone != -1 && PolygonZone != -1) { Chunk.ConnectZones(RoadZone, PolygonZone); }
+	}
+
+	PCGExZoneGraphStorage::FWriter Writer;
+	Writer.AddChunk(MoveTemp(Chunk));
+	Writer.Build();
+	const AZoneGraphData* Emitted = Writer.Emit(Actor, RF_Transient);
+
+	if (TestNotNull(TEXT("Emitted ZoneGraph Data"), Emitted))
+	{
+		const FZoneGraphStorage& Expected = Reference->GetStorage();
+		const FZoneGraphStorage& Actual = Emitted->GetStorage();
+
+		TestEqual(TEXT("Zones"), Actual.Zones.Num(), Expected.Zones.Num());
+		TestEqual(TEXT("Lanes"), Actual.Lanes.Num(), Expected.Lanes.Num());
+		TestEqual(TEXT("Lane links"), Actual.LaneLinks.Num(), Expected.LaneLinks.Num());
+
+		TArray<FString> ExpectedLanes;
+		TArray<FString> ActualLanes;
+		DescribeLanes(Expected, ExpectedLanes);
+		DescribeLanes(Actual, ActualLanes);
+
+		for (int32 i = 0; i < FMath::Min(ExpectedLanes.Num(), ActualLanes.Num()); i++)
+		{
+			TestEqual(*FString::Printf(TEXT("Lane %d and its links"), i), ActualLanes[i], ExpectedLanes[i]);
+		}
+	}
+
+	World->DestroyWorld(false);
+	return true;
+}
+
+#endif
@@ -0,0 +1,204 @@
+﻿// Copyright 2025 Timothé Lapetite and contributors
+// Released under the MIT license https://opensource.org/license/MIT/
+
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "HAL/FileManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Graph/PCGExClusterToZoneGraph.h"
+#include "Graph/PCGExZoneShapeBake.h"
+
+namespace PCGExZoneShapeBakeTests
+{
+	using namespace PCGExZoneShapeBake;
+
+	void AddTestPolygon(FChunk& Chunk, const uint64 ShapeId, const FVector& Center)
+	{
+		FShape Shape;
+		Shape.ShapeId = ShapeId;
+		Shape.Type = EShapeType::Polygon;
+		Shape.RoutingType = static_cast<uint8>(EZoneShapePolygonRoutingType::Arcs);
+		Shape.AdditionalTags = 0x4;
+		Chunk.AddShape(Shape, {FZoneShapePoint(Center + FVector(-100, 0, 0)), FZoneShapePoint(Center + FVector(0, 100, 0)), FZoneShapePoint(Center + FVector(100, 0, 0))});
+	}
+
+	/** Two chunks added out of order, the second one holding a spline linked to its polygon. */
+	void WriteTestShapes(TArray<uint8>& OutBlob, TArray<FZoneLaneProfileRef>& OutProfiles)
+	{
+		OutProfiles.SetNum(2);
+		for (FZoneLaneProfileRef& Profile : OutProfiles) { Profile.ID = FGuid::NewGuid(); }
+
+		FWriter Writer(OutProfiles);
+
+		FChunk Linked;
+		Linked.SortKey = 2;
+		AddTestPolygon(Linked, 20, FVector(1000, 0, 0));
+		{
+			FShape Shape;
+			Shape.ShapeId = 0xA5A5A5A500000015ull; // Past 32 bits
+			Shape.LaneProfile = 1;
+			Shape.EndShape = 0; // Chunk-local link to the polygon above
+			Linked.AddShape(Shape, {FZoneShapePoint(FVector(0, 0, 0)), FZoneShapePoint(FVector(900, 0, 0))});
+		}
+
+		FChunk Single;
+		Single.SortKey = 1;
+		AddTestPolygon(Single, 10, FVector::ZeroVector);
+		Single.Points[1].LaneProfile = 1;
+		Single.Points[2].Type = FZoneShapePointType::Bezier;
+		Single.Points[2].TangentLength = 42;
+
+		Writer.AddChunk(MoveTemp(Linked));
+		Writer.AddChunk(MoveTemp(Single));
+		Writer.Write(OutBlob);
+	}
+
+	void TestShapes(FAutomationTestBase& Test, const FShapesView& View, const TArray<FZoneLaneProfileRef>& Profiles)
+	{
+		if (!Test.TestEqual(TEXT("Profiles"), View.Profiles.Num(), 2) ||
+			!Test.TestEqual(TEXT("Shapes"), View.Shapes.Num(), 3) ||
+			!Test.TestEqual(TEXT("Points"), View.Points.Num(), 8))
+		{
+			return;
+		}
+
+		Test.TestEqual(TEXT("Profile ID"), View.Profiles[1].ID, Profiles[1].ID);
+
+		// Chunks are sorted by key, ranges and links of the later chunk are rebased past the earlier one
+		const FShape& Polygon = View.Shapes[0];
+		const FShape& Spline = View.Shapes[2];
+		Test.TestEqual(TEXT("Polygon identity"), Polygon.ShapeId, 10ull);
+		Test.TestTrue(TEXT("Polygon type"), Polygon.Type == EShapeType::Polygon);
+		Test.TestEqual(TEXT("Polygon routing"), Polygon.RoutingType, static_cast<uint8>(EZoneShapePolygonRoutingType::Arcs));
+		Test.TestEqual(TEXT("Polygon tags"), Polygon.AdditionalTags, 0x4u);
+		Test.TestEqual(TEXT("Polygon range"), Polygon.FirstPoint, 0);
+		Test.TestEqual(TEXT("Linked polygon range"), View.Shapes[1].FirstPoint, 3);
+		Test.TestEqual(TEXT("Spline identity"), Spline.ShapeId, 0xA5A5A5A500000015ull);
+		Test.TestTrue(TEXT("Spline type"), Spline.Type == EShapeType::Spline);
+		Test.TestEqual(TEXT("Spline range"), Spline.FirstPoint, 6);
+		Test.TestEqual(TEXT("Spline points"), Spline.NumPoints, 2);
+		Test.TestEqual(TEXT("Spline profile"), Spline.LaneProfile, 1);
+		Test.TestEqual(TEXT("Spline start link"), Spline.StartShape, -1);
+		Test.TestEqual(TEXT("Spline end link"), Spline.EndShape, 1);
+
+		Test.TestEqual(TEXT("Point position"), View.Points[7].Position, FVector(900, 0, 0));
+		Test.TestEqual(TEXT("Point profile"), View.Points[1].LaneProfile, static_cast<uint16>(1));
+		Test.TestEqual(TEXT("Point without profile"), View.Points[0].LaneProfile, NoLaneProfile);
+		Test.TestTrue(TEXT("Point type"), View.Points[2].Type == FZoneShapePointType::Bezier);
+		Test.TestEqual(TEXT("Point tangent"), View.Points[2].TangentLength, 42.f);
+	}
+
+	FShape& ShapeAt(TArray<uint8>& Blob, const int32 Index)
+	{
+		const FHeader* Header = reinterpret_cast<const FHeader*>(Blob.GetData());
+		return reinterpret_cast<FShape*>(Blob.GetData() + sizeof(FHeader) + Header->NumProfiles * sizeof(FProfile))[Index];
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FPCGExZoneShapeBakeRoundTripTest, "PCGEx.ZoneGraph.Bake.RoundTrip", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FPCGExZoneShapeBakeRoundTripTest::RunTest(const FString& Parameters)
+{
+	using namespace PCGExZoneShapeBake;
+	using namespace PCGExZoneShapeBakeTests;
+
+	TArray<uint8> Blob;
+	TArray<FZoneLaneProfileRef> Profiles;
+	WriteTestShapes(Blob, Profiles);
+
+	// Packed shapes are parsed in place
+	FShapesView Packed;
+	if (!TestTrue(TEXT("Parse packed shapes"), Packed.Parse(Blob.GetData(), Blob.Num()))) { return false; }
+	TestShapes(*this, Packed, Profiles);
+
+	// Baked files go through the memory-mapped path
+	const FString Path = FPaths::Combine(FPaths::AutomationTransientDir(), TEXT("PCGExZoneShapeBakeRoundTrip.pxzg"));
+	if (!TestTrue(TEXT("Save baked shapes"), FFileHelper::SaveArrayToFile(Blob, *Path))) { return false; }
+	{
+		FMappedShapes Mapped;
+		if (TestTrue(TEXT("Open baked shapes"), Mapped.Open(Path))) { TestShapes(*this, Mapped, Profiles); }
+	}
+	IFileManager::Get().Delete(*Path);
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FPCGExZoneShapeBakeParseTest, "PCGEx.ZoneGraph.Bake.RejectsInvalid", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FPCGExZoneShapeBakeParseTest::RunTest(const FString& Parameters)
+{
+	using namespace PCGExZoneShapeBake;
+	using namespace PCGExZoneShapeBakeTests;
+
+	TArray<uint8> Source;
+	TArray<FZoneLaneProfileRef> Profiles;
+	WriteTestShapes(Source, Profiles);
+
+	auto Rejects = [&](const TCHAR* What, TFunctionRef<void(TArray<uint8>&)> Corrupt)
+	{
+		TArray<uint8> Blob = Source;
+		Corrupt(Blob);
+		FShapesView View;
+		TestFalse(What, View.Parse(Blob.GetData(), Blob.Num()));
+	};
+
+	Rejects(TEXT("Older version"), [](TArray<uint8>& Blob) { reinterpret_cast<FHeader*>(Blob.GetData())->Version = 2; });
+	Rejects(TEXT("Truncated"), [](TArray<uint8>& Blob) { Blob.SetNum(Blob.Num() - 1); });
+	Rejects(TEXT("Wrapping point range"), [](TArray<uint8>& Blob) { ShapeAt(Blob, 2).FirstPoint = MAX_int32; });
+	Rejects(TEXT("Unknown shape type"), [](TArray<uint8>& Blob) { ShapeAt(Blob, 0).Type = static_cast<EShapeType>(7); });
+	Rejects(TEXT("Unknown routing type"), [](TArray<uint8>& Blob) { ShapeAt(Blob, 0).RoutingType = 9; });
+	Rejects(TEXT("Dangling link"), [](TArray<uint8>& Blob) { ShapeAt(Blob, 2).StartShape = 5; });
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FPCGExZoneGraphCacheHitRoutingTest, "PCGEx.ZoneGraph.Precompute.CacheHitRouting", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FPCGExZoneGraphCacheHitRoutingTest::RunTest(const FString& Parameters)
+{
+	using namespace PCGExClusterToZoneGraph;
+
+	// Cache hits reach the active writer like fresh precomputes, and are never stored back
+	const FPrecomputeRoute Baked = RoutePrecompute(true, true, true, true, false);
+	TestTrue(TEXT("Cache hit while baking"), Baked.Output == EPrecomputeOutput::Bake);
+	TestFalse(TEXT("Cache hit while baking is not stored"), Baked.bStore);
+
+	const FPrecomputeRoute Emitted = RoutePrecompute(true, true, true, false, true);
+	TestTrue(TEXT("Cache hit while emitting storage"), Emitted.Output == EPrecomputeOutput::Storage);
+	TestFalse(TEXT("Cache hit while emitting storage is not stored"), Emitted.bStore);
+
+	const FPrecomputeRoute Compiled = RoutePrecompute(true, true, true, false, false);
+	TestTrue(TEXT("Cache hit while compiling"), Compiled.Output == EPrecomputeOutput::Compile);
+	TestFalse(TEXT("Cache hit while compiling is not stored"), Compiled.bStore);
+
+	// Fresh precomputes are stored only when every shape was precomputed
+	TestTrue(TEXT("Complete precompute is stored"), RoutePrecompute(true, false, true, true, false).bStore);
+	TestFalse(TEXT("Partial precompute is not stored"), RoutePrecompute(true, false, false, false, false).bStore);
+	TestFalse(TEXT("Uncached precompute is not stored"), RoutePrecompute(false, false, true, false, true).bStore);
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FPCGExZoneGraphClaimFallbackTest, "PCGEx.ZoneGraph.Precompute.ClaimFallback", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FPCGExZoneGraphClaimFallbackTest::RunTest(const FString& Parameters)
+{
+	using namespace PCGExClusterToZoneGraph;
+
+	// A cache hit with dirty bounds leaves roads clean, and restored processors never select their kernels
+	const FPrecomputeRoute Restored = RoutePrecompute(true, true, true, false, false);
+	TestTrue(TEXT("Restored shapes are compiled"), Restored.Output == EPrecomputeOutput::Compile);
+	TestTrue(TEXT("Failed claim after a restore keeps the staged points"), ResolveClaimFallback(true, false) == EClaimFallback::UseStaged);
+	TestTrue(TEXT("Failed claim after a restore never precomputes"), ResolveClaimFallback(true, true) == EClaimFallback::UseStaged);
+
+	// Fresh clusters precompute the road, selecting the kernels first if no road needed them yet
+	TestTrue(TEXT("Failed claim precomputes"), ResolveClaimFallback(false, true) == EClaimFallback::Precompute);
+	TestTrue(TEXT("Failed claim selects missing kernels"), ResolveClaimFallback(false, false) == EClaimFallback::SelectKernels);
+
+	return true;
+}
+
+#endif
@@ -3,8 +3,11 @@
 
 #pragma once
 
+#include <atomic>
+
 #include "CoreMinimal.h"
 #include "PCGExGlobalSettings.h"
+#include "PCGManagedResource.h"
 #include "ZoneGraphSettings.h"
 #include "ZoneGraphTypes.h"
 #include "ZoneShapeComponent.h"
@@ -51,6 +54,46 @@ namespace PCGExMT
 	class FTimeSlicedMainThreadLoop;
 }
 
+namespace PCGExZoneShapeBake
+{
+	class FWriter;
+	struct FChunk;
+}
+
+namespace PCGExZoneGraphStorage
+{
+	class FWriter;
+	struct FChunk;
+}
+
+class UPCGExManagedZoneShapeComponent;
+
+namespace PCGExClusterToZoneGraph
+{
+	/** Interned lane profile, with widths resolved once at boot. */
+	struct FLaneProfileEntry
+	{
+		FZoneLaneProfileRef Profile;
+		double TotalWidth = 0;
+		double MaxLaneWidth = 0;
+
+		FLaneProfileEntry() = default;
+		explicit FLaneProfileEntry(const FZoneLaneProfileRef& InProfile);
+	};
+
+	/** Compiled shape whose update and registration are held until generation completes (editor only). */
+	struct FHeldShape
+	{
+		TObjectPtr<AActor> TargetActor;
+		TObjectPtr<UZoneShapeComponent> Component;
+		TObjectPtr<UPCGExManagedZoneShapeComponent> ManagedShape;
+		FAttachmentTransformRules AttachmentRules = FAttachmentTransformRules::KeepWorldTransform;
+		bool bAttach = false; // False for reused components, which are already attached
+	};
+
+	class FCompileScheduler;
+}
+
 UCLASS(MinimalAPI, BlueprintType, ClassGroup = (Procedural), Category="PCGEx|Clusters", meta=(PCGExNodeLibraryDoc="cluster-to-zone-graph"))
 class UPCGExClusterToZoneGraphSettings : public UPCGExClustersProcessorSettings
 {
@@ -78,6 +121,7 @@ public:
 
 protected:
 	virtual bool OutputPinsCanBeDeactivated() const override { return true; }
+	virtual TArray<FPCGPinProperties> InputPinProperties() const override;
 	virtual TArray<FPCGPinProperties> OutputPinProperties() const override;
 	virtual FPCGElementPtr CreateElement() const override;
 	virtual bool ShouldCache() const override { return false; }
@@ -184,6 +228,11 @@ public:
 		EditCondition="bCachedSupportsCustomLength && RoadTangentLengthMode != EPCGExZGTangentLengthMode::Default", EditConditionHides, HideEditConditionToggle))
 	double TangentLengthScale = 1.0;
 
+	/** Compute Auto/Catmull-Rom tangents in single precision. Faster, at the cost of accuracy far from the world origin. */
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "Settings|ZoneGraph", AdvancedDisplay,
+		meta=(EditCondition="bCachedSupportsCustomLength && (RoadTangentLengthMode == EPCGExZGTangentLengthMode::Auto || RoadTangentLengthMode == EPCGExZGTangentLengthMode::CatmullRom)", EditConditionHides))
+	bool bFloatPrecisionTangents = false;
+
 	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "Settings|ZoneGraph", meta=(PCG_NotOverridable, InlineEditConditionToggle))
 	bool bOverrideRoadPointType = false;
 	
@@ -228,6 +277,29 @@ public:
 
 	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = Settings, meta=(PCG_Overridable, EditCondition="bOutputRoadPaths"))
 	FName LeaveName = "LeaveTangent";
+
+	/** Write every shape to a baked binary file instead of spawning one component per shape.
+	 * The target actor gets a single Baked Zone Shapes component that memory-maps the file and feeds its lanes to a transient ZoneGraph Data actor on load.
+	 * Path outputs and component reuse don't apply when baking. */
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "Settings|Output")
+	bool bBakeShapes = false;
+
+	/** Baked file path, relative to the project directory. Empty writes one file per level, actor and node under Content/PCGEx/ZoneShapes.
+	 * Files under the Content directory are added to the packaging settings' loose files, so they're staged with cooked builds. */
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "Settings|Output", meta=(PCG_Overridable, EditCondition="bBakeShapes"))
+	FString BakedShapesFile;
+
+	/** Tessellate every shape straight into the lane storage of a new ZoneGraph Data actor on worker threads, without creating any shape component.
+	 * Meant for runtime and cooked builds that only need lanes: shapes can't be edited afterward, path outputs and component reuse don't apply,
+	 * and a ZoneGraph build in the editor may overwrite the level's data from shape components. Ignored when baking. */
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "Settings|Output")
+	bool bEmitZoneGraphStorage = false;
+
+	/** Store every shape in a single container component on the target actor instead of one component per shape.
+	 * Shapes are packed in the baked layout and saved with the level, and their lanes are fed to a transient ZoneGraph Data actor on load.
+	 * Path outputs and component reuse don't apply. Ignored when baking or emitting storage. */
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "Settings|Output")
+	bool bPackShapes = false;
 	
 	
 	/** Specify a list of functions to be called on the target actor after dynamic mesh creation. Functions need to be parameter-less and with "CallInEditor" flag enabled. */
@@ -237,21 +309,173 @@ public:
 	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = Settings, AdvancedDisplay)
 	FPCGExAttachmentRules AttachmentRules;
 
+	/** Game-thread time budget per frame for component creation, in milliseconds.
+	 * Shape costs are measured as they compile, and each frame is packed up to this budget. */
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = Settings, AdvancedDisplay, meta=(ClampMin=0.1, UIMin=0.1))
+	double CompileFrameBudgetMs = 4;
+
+	/** Keep zone shape components across regenerations. Each shape gets a stable identity from its source points
+	 * and a hash of its content: unchanged shapes are left untouched, changed ones are updated in place,
+	 * and only new or removed shapes are created or destroyed. */
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = Settings, AdvancedDisplay)
+	bool bReuseComponents = false;
+
+	/** Keep the chains and precomputed shapes of each cluster in process-wide caches, keyed by a hash of what they were built from.
+	 * Re-executions with identical clusters skip straight to component creation,
+	 * and clusters whose topology and breakpoints are unchanged skip filtering and chain extraction.
+	 * Shapes are never cached with Sort Direction orientation, since sorting rules read arbitrary attributes. */
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = Settings, AdvancedDisplay)
+	bool bCachePrecompute = false;
+
+	/** Precompute and compile roads in spatially coherent windows sharing a single staging range, so peak memory stays bounded on very large clusters.
+	 * Ignored when caching precomputed shapes or baking, which need every shape staged at once. */
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = Settings, AdvancedDisplay)
+	bool bStreamShapes = false;
+
+	/** Maximum number of roads per streaming window. */
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = Settings, AdvancedDisplay, meta=(EditCondition="bStreamShapes", ClampMin=1, UIMin=1))
+	int32 StreamWindowSize = 4096;
+
+	/** Staging memory ceiling of a single cluster while streaming, in megabytes. Windows shrink to fit under it.
+	 * Only bounds the staged shape points: the cluster, its chains and per-road bookkeeping stay alive until the cluster is done. */
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = Settings, AdvancedDisplay, meta=(EditCondition="bStreamShapes", ClampMin=1, UIMin=1))
+	double StreamMemoryCeilingMb = 64;
+
+	/** Split each cluster into spatial tiles and assemble its shapes and depth-first orientation across them concurrently, for very large single clusters.
+	 * Polygons belong to the tile of their node and roads to their chain, and polygons are moved back to the untiled order once assembled,
+	 * so shapes, their order and identities match the untiled result regardless of thread count. */
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = Settings, AdvancedDisplay)
+	bool bTiledProcessing = false;
+
+	/** Approximate number of nodes per tile. */
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = Settings, AdvancedDisplay, meta=(EditCondition="bTiledProcessing", ClampMin=1, UIMin=1))
+	int32 TileSize = 16384;
+
+	/** Log time spent per frame and worst hitch of the component creation loop. */
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = Settings, AdvancedDisplay)
+	bool bLogCompileStats = false;
+
 private:
 	friend class FPCGExClusterToZoneGraphElement;
 };
 
+/** Managed zone shape component that survives soft cleanups, so the next execution can pick it back up by identity.
+ * Components that aren't reused are released as unused once generation completes. */
+UCLASS(MinimalAPI, BlueprintType)
+class UPCGExManagedZoneShapeComponent : public UPCGManagedComponent
+{
+	GENERATED_BODY()
+
+public:
+	virtual bool SupportsComponentReset() const override { return true; }
+
+	/** Nothing to reset: the next execution compares the content hash and updates the shape in place, or leaves it untouched. */
+	virtual void ResetComponent() override { }
+
+	/** 64-bit shape identity, 0 when the shape had none. */
+	UPROPERTY()
+	uint64 ShapeId = 0;
+
+	UPROPERTY()
+	uint32 ContentHash = 0;
+
+	/** Shape tags before any per-shape additions. */
+	UPROPERTY()
+	FZoneGraphTagMask BaseTags = FZoneGraphTagMask::None;
+};
+
 struct FPCGExClusterToZoneGraphContext final : FPCGExClustersProcessorContext
 {
 	friend class FPCGExClusterToZoneGraphElement;
 
-	TArray<FString> ComponentTags;
+	TArray<FName> ComponentTags;
+	int32 ComponentNameCounter = 0;
 
-	TMap<FName, FZoneLaneProfileRef> LaneProfileMap;
+	/** Interned lane profiles. Index 0 is always the settings' default profile. */
+	TArray<PCGExClusterToZoneGraph::FLaneProfileEntry> LaneProfiles;
+	TMap<FName, int32> LaneProfileMap;
 
 	TSharedPtr<PCGExData::FPointIOCollection> OutputPolygonPaths;
 	TSharedPtr<PCGExData::FPointIOCollection> OutputRoadPaths;
 
+	/** Game-thread component compilation shared by every processor of this context. */
+	TSharedPtr<PCGExClusterToZoneGraph::FCompileScheduler> CompileScheduler;
+
+	/** Set once the remaining work must run on the game thread. */
+	bool bRequiresGameThread = false;
+
+	/** Unique component name within the given outer. Game thread only. */
+	FName MakeComponentName(UObject* InOuter);
+
+	/** Components left by the previous execution, by shape identity. Filled at boot, read-only afterward. */
+	TMap<uint64, UPCGExManagedZoneShapeComponent*> ReusableShapes;
+	int32 NumUpdatedShapes = 0;
+	int32 NumUnchangedShapes = 0;
+
+	/** Hash of the settings and lane profiles shared by every cluster key, set when the precompute cache is in use. */
+	bool bUsePrecomputeCache = false;
+	uint64 PrecomputeSettingsHash = 0;
+	FThreadSafeCounter NumPrecomputeHits;
+	FThreadSafeCounter NumPrecomputeMisses;
+
+	/** Hash of the breakpoint filters shared by every cluster chain key, set when the chain cache is in use. */
+	bool bUseChainCache = false;
+	uint64 ChainFilterHash = 0;
+	FThreadSafeCounter NumChainHits;
+	FThreadSafeCounter NumFilterSkips;
+
+	/** Shape staging memory held by every processor, and its high-water mark. */
+	std::atomic<int64> StagingBytes{0};
+	std::atomic<int64> PeakStagingBytes{0};
+	void TrackStagingBytes(const int64 Delta);
+
+	/** Gathers baked or packed shapes from every processor, written once processing completes. */
+	TSharedPtr<PCGExZoneShapeBake::FWriter> BakeWriter;
+	bool WriteBakedShapes(const UPCGExClusterToZoneGraphSettings* Settings);
+
+	/** Gathers tessellated lanes from every processor, merged and handed to a ZoneGraph Data actor once processing completes. */
+	TSharedPtr<PCGExZoneGraphStorage::FWriter> StorageWriter;
+	TArray<FZoneLaneProfile> StorageLaneProfiles; // Resolved interned lane profiles
+	FZoneGraphTagMask StorageDefaultTags = FZoneGraphTagMask::None;
+	bool WriteZoneGraphStorage();
+
+	/** Regions to rebuild when reusing components. Empty means everything is rebuilt. */
+	TArray<FBox> DirtyBounds;
+
+	/** Gathers the previous execution's shapes that can be claimed: unused, still a live zone shape, owned by the target actor. Game thread only. */
+	void CollectReusableShapes(const AActor* InTargetActor);
+	bool HasReusableShape(const uint64 ShapeId) const;
+
+	/** Claims a previous component for reuse. Game thread only. */
+	UPCGExManagedZoneShapeComponent* ClaimReusableShape(const uint64 ShapeId, const AActor* InTargetActor);
+
+	/** Attaches a compiled shape component to its actor, through its own managed shape when reused. Game thread only. */
+	void AttachShapeComponent(AActor* InTargetActor, UZoneShapeComponent* InComponent, UPCGExManagedZoneShapeComponent* InManagedShape, const FAttachmentTransformRules& InRules);
+
+#if WITH_EDITOR
+	/** Set at boot when the project builds ZoneGraph while editing. Every registered or updated shape would otherwise
+	 * trigger a rebuild on the next tick, so they are held until processing completes and followed by a single explicit rebuild. */
+	bool bHoldZoneGraphBuilds = false;
+	TArray<PCGExClusterToZoneGraph::FHeldShape> HeldShapes;
+	int32 NumReleasedShapes = 0;
+
+	/** Ticks on which shapes were held and released, each of which would have rebuilt the ZoneGraph data. */
+	int32 NumHoldTicks = 0;
+	int32 NumReleaseTicks = 0;
+	uint64 LastHoldFrame = MAX_uint64;
+	uint64 LastReleaseFrame = MAX_uint64;
+
+	virtual void AddExtraStructReferencedObjects(FReferenceCollector& Collector) override;
+#endif
+
+	/** Queues a compiled shape until generation completes. Game thread only. */
+	void HoldShape(AActor* InTargetActor, UZoneShapeComponent* InComponent, UPCGExManagedZoneShapeComponent* InManagedShape, const FAttachmentTransformRules& InRules, const bool bAttach);
+	bool HasHeldShapes() const;
+
+	/** Updates and attaches held shapes within the compile budget, then rebuilds the ZoneGraph data of their levels once.
+	 * Returns false while shapes are left to release. Game thread only. */
+	bool ReleaseHeldShapes(const UPCGExClusterToZoneGraphSettings* Settings);
+
 protected:
 	PCGEX_ELEMENT_BATCH_EDGE_DECL
 };
@@ -264,7 +488,7 @@ protected:
 	virtual bool Boot(FPCGExContext* InContext) const override;
 	virtual bool AdvanceWork(FPCGExContext* InContext, const UPCGExSettings* InSettings) const override;
 
-	virtual bool CanExecuteOnlyOnMainThread(FPCGContext* Context) const override { return true; }
+	virtual bool CanExecuteOnlyOnMainThread(FPCGContext* Context) const override;
 	virtual bool IsCacheable(const UPCGSettings* InSettings) const override { return false; }
 };
 
@@ -272,24 +496,244 @@ namespace PCGExClusterToZoneGraph
 {
 	class FProcessor;
 
-	class FZGBase : public TSharedFromThis<FZGBase>
+	/** Structure-of-arrays staging for the shape points of every road and polygon of a processor.
+	 * Each shape owns a contiguous [PointOffset, PointOffset + PointCapacity) range. */
+	struct FShapePointBuffer
+	{
+		TArray<FVector> Positions;
+		TArray<FVector> Forwards;
+		TArray<FRotator> Rotations; // Built from Forwards on worker threads, once precompute settles them
+		TArray<float> TangentLengths;
+		TArray<FZoneShapePointType> Types;
+
+		void SetNum(const int32 InNum);
+		void Empty();
+		SIZE_T GetAllocatedSize() const;
+	};
+
+	/** Tangent length source of road points, resolved once per processor to pick a specialized road kernel. */
+	enum class ERoadTangentKernel : uint8
+	{
+		None = 0,
+		Manual,
+		ManualConstant,
+		Auto,
+		CatmullRom,
+	};
+
+	/** Where a cluster's shapes go once precomputed or restored from the cache. */
+	enum class EPrecomputeOutput : uint8
+	{
+		Compile = 0, // One component per shape
+		Bake    = 1, // Baked file or packed container
+		Storage = 2, // ZoneGraph lane storage
+	};
+
+	struct FPrecomputeRoute
+	{
+		bool bStore = false; // Whether the precomputed shapes are added to the cache
+		EPrecomputeOutput Output = EPrecomputeOutput::Compile;
+	};
+
+	/** Same routing for fresh and restored shapes, restored ones are never stored back. */
+	FPrecomputeRoute RoutePrecompute(const bool bCachePrecompute, const bool bRestored, const bool bComplete, const bool bBake, const bool bStorage);
+
+	/** What a clean road needs before it is compiled, once its previous component couldn't be claimed. */
+	enum class EClaimFallback : uint8
+	{
+		UseStaged     = 0, // Restored from the cache, its points are already staged
+		Precompute    = 1, // Precomputed with the kernels already selected
+		SelectKernels = 2, // Kernels are selected first, then precomputed
+	};
+
+	EClaimFallback ResolveClaimFallback(const bool bRestored, const bool bKernelsSelected);
+
+	/** Untiled polygons are created by the first road reaching their node, at its start before its end.
+	 * Tiled polygons are keyed the same way so they can be moved back to that order. */
+	FORCEINLINE int32 GetPolygonOrderKey(const int32 Road, const bool bFromStart) { return Road * 2 + (bFromStart ? 0 : 1); }
+
+	/** Maps unique order keys below NumKeys to dense slots, in key order. */
+	void RankPolygonOrderKeys(TConstArrayView<int32> Keys, const int32 NumKeys, TArray<int32>& OutSlots);
+
+	/** Heap allocator counting the allocations made on the calling thread, so scratch growth can be measured without touching GMalloc. */
+	class FScratchAllocator : public FHeapAllocator
+	{
+	public:
+		class ForAnyElementType : public FHeapAllocator::ForAnyElementType
+		{
+		public:
+			template <typename... ArgTypes>
+			FORCEINLINE void ResizeAllocation(const SizeType CurrentNum, const SizeType NewMax, ArgTypes... Args)
+			{
+				if (NewMax > 0) { ++GetThreadAllocations(); }
+				FHeapAllocator::ForAnyElementType::ResizeAllocation(CurrentNum, NewMax, Args...);
+			}
+		};
+
+		template <typename ElementType>
+		class ForElementType : public ForAnyElementType
+		{
+		public:
+			FORCEINLINE ElementType* GetAllocation() const { return (ElementType*)ForAnyElementType::GetAllocation(); }
+		};
+
+		static uint32& GetThreadAllocations()
+		{
+			static thread_local uint32 NumAllocations = 0;
+			return NumAllocations;
+		}
+	};
+
+	template <typename T>
+	using TScratchArray = TArray<T, FScratchAllocator>;
+
+	/** Split X/Y/Z arrays of a staged point range, so road kernels load four points per register.
+	 * Sized past the range by a whole register, which is zeroed, so the last block never reads out of bounds. */
+	template <typename T>
+	struct TSplitVectors
+	{
+		TScratchArray<T> X;
+		TScratchArray<T> Y;
+		TScratchArray<T> Z;
+
+		void SetNum(const int32 Num)
+		{
+			X.SetNumUninitialized(Num + 4, EAllowShrinking::No);
+			Y.SetNumUninitialized(Num + 4, EAllowShrinking::No);
+			Z.SetNumUninitialized(Num + 4, EAllowShrinking::No);
+			for (int32 i = Num; i < Num + 4; i++) { X[i] = Y[i] = Z[i] = 0; }
+		}
+
+		void Split(const FVector* Vectors, const int32 Num, const FVector& Origin)
+		{
+			SetNum(Num);
+			for (int32 i = 0; i < Num; i++)
+			{
+				X[i] = static_cast<T>(Vectors[i].X - Origin.X);
+				Y[i] = static_cast<T>(Vectors[i].Y - Origin.Y);
+				Z[i] = static_cast<T>(Vectors[i].Z - Origin.Z);
+			}
+		}
+
+		FVector Get(const int32 Index) const { return FVector(X[Index], Y[Index], Z[Index]); }
+	};
+
+	/** Kernel lanes of one precision: points, per-point directions and lengths. */
+	template <typename T>
+	struct TKernelLanes
+	{
+		TSplitVectors<T> Points;
+		TSplitVectors<T> Directions;
+		TScratchArray<T> Lengths;
+	};
+
+	/** Scratch memory reused across iterations of a precompute scope,
+	 * so steady-state road processing doesn't allocate. */
+	struct FPrecomputeScratch
+	{
+		TArray<int32> Nodes; // Filled by the chain, reserved once per scope
+		TKernelLanes<double> Lanes;
+		TKernelLanes<float> LanesSingle; // Single precision tangents
+		TScratchArray<int32> ProfileCounts;
+		TScratchArray<int32> SeenProfiles;
+
+		template <typename T>
+		TKernelLanes<T>& GetLanes()
+		{
+			if constexpr (std::is_same_v<T, float>) { return LanesSingle; }
+			else { return Lanes; }
+		}
+	};
+
+	/** Per-processor inputs of road precompute, resolved once alongside the road kernels. */
+	struct FRoadPrecomputeParams
+	{
+		FShapePointBuffer* Staging = nullptr;
+		FZoneShapePointType PointType = FZoneShapePointType::AutoBezier;
+		double EndpointTrimBuffer = 0;
+		double TangentLengthScale = 1;
+		float ConstantTangentLength = 0;
+		bool bFloatPrecisionTangents = false;
+		PCGExData::TBuffer<int32>* PointTypeBuffer = nullptr;
+		PCGExDetails::TSettingValue<double>* TangentLengthGetter = nullptr;
+	};
+
+	/** Online per-shape cost estimate and per-tick telemetry of the game-thread compile scheduler. */
+	struct FCompileBudget
+	{
+		static constexpr int32 MaxBatchSize = 256;
+
+		double BudgetSeconds = 0.004;
+		double PolygonCost = 0;
+		double RoadCost = 0;
+
+		int32 NumTicks = 0;
+		double TotalSeconds = 0;
+		double WorstTickSeconds = 0;
+
+		double Estimate(const bool bPolygon) const { return bPolygon ? PolygonCost : RoadCost; }
+		void Record(const bool bPolygon, const double Seconds);
+		void RecordTick(const double Seconds);
+	};
+
+	/** A non-leaf chain end, one entry of the per-node connector table in FProcessor::Connections.
+	 * Each node owns a contiguous range of these, which its polygon (if any) owns in turn. */
+	struct FZGConnection
+	{
+		FVector Direction = FVector::ZeroVector; // outward from the node along the chain
+		double AngleKey = 0;                     // heading in (-pi, pi], polygon ordering key
+		int32 Road = -1;                         // chain index, which is also the road slot
+		int32 Opposite = -1;                     // node at the other chain end, -1 if that end is a leaf
+		double Radius = 0;
+		bool bAtSeed = false;
+		bool bFromStart = false; // resolved once roads are oriented
+
+		FZGConnection() = default;
+
+		FZGConnection(const int32 InRoad, const bool bInAtSeed, const int32 InOpposite)
+			: Road(InRoad), Opposite(InOpposite), bAtSeed(bInAtSeed)
+		{
+		}
+	};
+
+	/** Roads and polygons are plain records stored by value in processor-owned arrays, and reference each other by index. */
+	class FZGBase
 	{
 	protected:
 		FProcessor* Processor = nullptr;
-		TArray<FZoneShapePoint> PrecomputedPoints;
 
 	public:
 		UZoneShapeComponent* Component = nullptr;
-		double StartRadius = 0;
-		double EndRadius = 0;
+		UPCGExManagedZoneShapeComponent* ManagedShape = nullptr; // Only when reusing components
+
+		int32 PointOffset = 0;
+		int32 PointCapacity = 0;
+		int32 NumPoints = 0;
+
+		uint64 ShapeId = 0; // 0 when the identity collided
+		uint32 ContentHash = 0;
+		bool bDirty = true; // Clean shapes keep their previous component as-is
 
 		explicit FZGBase(FProcessor* InProcessor);
+		void SetProcessor(FProcessor* InProcessor) { Processor = InProcessor; }
 		void InitComponent(AActor* InTargetActor);
+
+		/** Picks up the previous execution's component for this shape, if any. */
+		bool TryReuseComponent(AActor* InTargetActor, bool& bOutUnchanged);
+		bool KeepComponent(AActor* InTargetActor);
+
+		uint32 HashStagedPoints(const uint32 Seed) const;
+
+		/** Builds final zone shape points from the staged range. */
+		void MaterializePoints(TArray<FZoneShapePoint>& OutPoints, const bool bWriteTangentLengths) const;
 	};
 
 	class FZGRoad : public FZGBase
 	{
 	public:
+		/** Polygon boundary data for one end of the road.
+		 * Each endpoint (and its matching Start/EndRadius) is only ever written by the polygon sitting on that end,
+		 * so polygons can precompute in parallel without synchronization. */
 		struct FPolygonEndpoint
 		{
 			FVector PolygonCenter = FVector::ZeroVector;
@@ -298,56 +742,205 @@ namespace PCGExClusterToZoneGraph
 			bool bValid = false;
 		};
 
-		TSharedPtr<PCGExClusters::FNodeChain> Chain;
+		PCGExClusters::FNodeChain* Chain = nullptr; // Owned by FProcessor::ProcessedChains
 		bool bIsReversed = false;
 
+		int32 StartPolygon = -1;
+		int32 EndPolygon = -1;
+		double StartRadius = 0;
+		double EndRadius = 0;
+
 		FPolygonEndpoint StartEndpoint;
 		FPolygonEndpoint EndEndpoint;
 		bool bDegenerate = false;
 
-		FZoneLaneProfileRef CachedLaneProfile;
-		double CachedMaxLaneWidth = 0;
-		double CachedTotalProfileWidth = 0;
+		int32 LaneProfileIndex = 0;
 
-		explicit FZGRoad(FProcessor* InProcessor, const TSharedPtr<PCGExClusters::FNodeChain>& InChain, const bool InReverse);
-		void ResolveLaneProfile(const TSharedPtr<PCGExClusters::FCluster>& Cluster);
-		void Precompute(const TSharedPtr<PCGExClusters::FCluster>& Cluster);
+		explicit FZGRoad(FProcessor* InProcessor, PCGExClusters::FNodeChain* InChain, const bool InReverse);
+		void ResolveLaneProfile(const TSharedPtr<PCGExClusters::FCluster>& Cluster, FPrecomputeScratch& Scratch);
+		void Precompute(const TSharedPtr<PCGExClusters::FCluster>& Cluster, FPrecomputeScratch& Scratch);
 		void Compile();
+		void Bake(PCGExZoneShapeBake::FChunk& OutChunk, TArray<FZoneShapePoint>& Scratch) const;
+		int32 Emit(PCGExZoneGraphStorage::FChunk& OutChunk, TArray<FZoneShapePoint>& Scratch) const;
 		void BuildPathOutput(const TSharedPtr<PCGExData::FPointIO>& InPathIO) const;
+
+		using FPrecomputeKernel = void (FZGRoad::*)(const TSharedPtr<PCGExClusters::FCluster>&, FPrecomputeScratch&);
+
+		/** Road precompute specialized on per-processor settings, so the per-point loop carries no mode branches. */
+		template <bool bHasTypeBuffer, ERoadTangentKernel TangentKernel, bool bTrim, bool bClosedLoop>
+		void PrecomputeImpl(const TSharedPtr<PCGExClusters::FCluster>& Cluster, FPrecomputeScratch& Scratch);
+
+		/** Precompute body over the chain nodes listed in Scratch.Nodes, read through a cluster-like node accessor.
+		 * Defined in PCGExClusterToZoneGraphKernels.h. */
+		template <bool bHasTypeBuffer, ERoadTangentKernel TangentKernel, bool bTrim, bool bClosedLoop, typename TNodes>
+		void PrecomputeNodes(const TNodes& InNodes, const FRoadPrecomputeParams& Params, FPrecomputeScratch& Scratch);
 	};
 
 	class FZGPolygon : public FZGBase
 	{
 	protected:
-		TArray<TSharedPtr<FZGRoad>> Roads;
-		TBitArray<> FromStart;
-
 		double CachedRadius = 0;
-		TArray<double> CachedRoadRadii;
 		EZoneShapePolygonRoutingType CachedRoutingType = EZoneShapePolygonRoutingType::Arcs;
 		FZoneShapePointType CachedPointType = FZoneShapePointType::LaneProfile;
 		FZoneGraphTagMask CachedAdditionalTags = FZoneGraphTagMask::None;
-		FZoneLaneProfileRef CachedLaneProfile;
-		TArray<FZoneLaneProfileRef> CachedPointLaneProfiles;
-		TArray<double> CachedPointHalfWidths;
 
 	public:
 		int32 NodeIndex = -1;
+		int32 FirstConnection = 0;
+		int32 NumConnections = 0;
 
 		explicit FZGPolygon(FProcessor* InProcessor, const PCGExClusters::FNode* InNode);
 
-		void Add(const TSharedPtr<FZGRoad>& InRoad, bool bFromStart);
+		TArrayView<FZGConnection> GetConnections() const;
 		void Precompute(const TSharedPtr<PCGExClusters::FCluster>& Cluster);
 		void SyncRadiusToRoads();
 		void BuildPathOutput(const TSharedPtr<PCGExData::FPointIO>& InPathIO) const;
 		void Compile();
+		void Bake(PCGExZoneShapeBake::FChunk& OutChunk, TArray<FZoneShapePoint>& Scratch) const;
+		int32 Emit(PCGExZoneGraphStorage::FChunk& OutChunk, TArray<FZoneShapePoint>& Scratch, TArray<FZoneLaneProfile>& ProfileScratch) const;
+	};
+
+	/** Fully precomputed shapes of one cluster, immutable once cached.
+	 * Shapes are stored before compilation, without components, and rebound to the processor that restores them. */
+	struct FPrecomputedShapes
+	{
+		TArray<TSharedPtr<PCGExClusters::FNodeChain>> Chains;
+		TArray<FZGRoad> Roads;
+		TArray<FZGPolygon> Polygons;
+		TArray<FZGConnection> Connections;
+		FShapePointBuffer ShapePoints;
+
+		SIZE_T GetAllocatedSize() const;
+	};
+
+	/** Breakpoints and the chains resolved from them, immutable once cached. */
+	struct FResolvedChains
+	{
+		uint32 VtxCrc = 0; // Input vtx data the breakpoint filters ran against
+		TArray<int8> Breakpoints;
+		TArray<TSharedPtr<PCGExClusters::FNodeChain>> Chains;
+
+		SIZE_T GetAllocatedSize() const;
+	};
+
+	/** Process-wide cache of immutable per-cluster artifacts, keyed by a hash of whatever they were built from.
+	 * Least recently used entries are evicted past the memory cap given when adding. */
+	template <typename T>
+	class TArtifactCache
+	{
+	public:
+		struct FStats
+		{
+			int32 NumEntries = 0;
+			SIZE_T AllocatedSize = 0;
+			int32 NumHits = 0;
+			int32 NumMisses = 0;
+			int32 NumEvictions = 0;
+		};
+
+	protected:
+		struct FEntry
+		{
+			TSharedPtr<const T> Value;
+			SIZE_T Size = 0;
+			uint64 LastUse = 0;
+		};
+
+		mutable FCriticalSection Lock;
+		TMap<uint64, FEntry> Entries;
+		uint64 UseCounter = 0;
+		FStats Stats;
+
+	public:
+		static TArtifactCache& Get()
+		{
+			static TArtifactCache Instance;
+			return Instance;
+		}
+
+		TSharedPtr<const T> Find(const uint64 Key)
+		{
+			FScopeLock ScopeLock(&Lock);
+
+			FEntry* Entry = Entries.Find(Key);
+			if (!Entry)
+			{
+				Stats.NumMisses++;
+				return nullptr;
+			}
+
+			Stats.NumHits++;
+			Entry->LastUse = ++UseCounter;
+			return Entry->Value;
+		}
+
+		void Add(const uint64 Key, const TSharedPtr<const T>& InValue, const SIZE_T MaxSize)
+		{
+			const SIZE_T Size = InValue->GetAllocatedSize();
+			if (Size > MaxSize) { return; }
+
+			FScopeLock ScopeLock(&Lock);
+
+			FEntry& Entry = Entries.FindOrAdd(Key);
+			Stats.AllocatedSize += Size - Entry.Size;
+			Entry.Value = InValue;
+			Entry.Size = Size;
+			Entry.LastUse = ++UseCounter;
+
+			Trim(MaxSize);
+		}
+
+		void Empty()
+		{
+			FScopeLock ScopeLock(&Lock);
+			Entries.Empty();
+			Stats.AllocatedSize = 0;
+		}
+
+		FStats GetStats() const
+		{
+			FScopeLock ScopeLock(&Lock);
+			FStats Out = Stats;
+			Out.NumEntries = Entries.Num();
+			return Out;
+		}
+
+	protected:
+		void Trim(const SIZE_T MaxSize)
+		{
+			// Entries are few (one per cluster), a linear scan for the oldest is cheaper than maintaining an ordered list
+			while (Stats.AllocatedSize > MaxSize && !Entries.IsEmpty())
+			{
+				uint64 OldestKey = 0;
+				uint64 OldestUse = MAX_uint64;
+				for (const TPair<uint64, FEntry>& Pair : Entries)
+				{
+					if (Pair.Value.LastUse < OldestUse)
+					{
+						OldestUse = Pair.Value.LastUse;
+						OldestKey = Pair.Key;
+					}
+				}
+
+				Stats.AllocatedSize -= Entries.FindAndRemoveChecked(OldestKey).Size;
+				Stats.NumEvictions++;
+			}
+		}
 	};
 
+	/** Capped by pcgex.ZoneGraph.PrecomputeCacheMaxMB. */
+	using FPrecomputeCache = TArtifactCache<FPrecomputedShapes>;
+
+	/** Capped by pcgex.ZoneGraph.ChainCacheMaxMB. */
+	using FChainCache = TArtifactCache<FResolvedChains>;
+
 	class FProcessor final : public PCGExClusterMT::TProcessor<FPCGExClusterToZoneGraphContext, UPCGExClusterToZoneGraphSettings>
 	{
 		friend class FBatch;
+		friend class FZGBase;
 		friend class FZGRoad;
 		friend class FZGPolygon;
+		friend class FCompileScheduler;
 
 	protected:
 		FPCGExEdgeDirectionSettings DirectionSettings;
@@ -355,12 +948,59 @@ namespace PCGExClusterToZoneGraph
 		AActor* TargetActor = nullptr;
 		FAttachmentTransformRules CachedAttachmentRules = FAttachmentTransformRules::KeepWorldTransform;
 
-		TSharedPtr<PCGExMT::FTimeSlicedMainThreadLoop> MainCompileLoop;
+		int32 CompileCursor = 0;
+		bool bCompilePrepared = false;
+		EObjectFlags CachedObjectFlags = RF_NoFlags;
+		TArray<FZGBase*> CompileBatch;
 
-		TArray<TSharedPtr<PCGExClusters::FNodeChain>> ProcessedChains;
+		bool bCachePrecompute = false;
+		bool bPrecomputeRestored = false;
+		uint64 PrecomputeKey = 0;
 
-		TArray<TSharedPtr<FZGRoad>> Roads;
-		TArray<TSharedPtr<FZGPolygon>> Polygons;
+		bool bCacheChains = false;
+		uint64 ChainKey = 0;
+		uint32 VtxCrc = 0;
+		TSharedPtr<const FResolvedChains> CachedChains;
+
+		bool bReuseComponents = false;
+		uint64 ShapeIdSeed = 0;
+		uint32 ShapeSettingsHash = 0;
+
+		TArray<TSharedPtr<PCGExClusters::FNodeChain>> ProcessedChains;
+		TArray<bool> ChainReversed;
+
+		FShapePointBuffer ShapePoints;
+		int32 MaxRoadPointCapacity = 0;
+		int64 StagingBytes = 0;
+
+		// Roads are precomputed and compiled window by window, each window reusing the same staging range.
+		// Without streaming, a single window holds every road in slot order.
+		bool bStreaming = false;
+		TArray<int32> RoadOrder;    // Road slots in window order, empty when not streaming
+		TArray<int32> WindowStarts; // Offsets into the window order, with a trailing end offset
+		int32 CurrentWindow = 0;
+		int32 CompileEnd = 0; // End of the shapes ready to compile, in compile order
+		std::atomic<bool> bWindowInFlight{false};
+
+		// Depth-first orientation scratch, released once shapes are built
+		TArray<int32> NodeDepth;
+		TArray<int32> ComponentSeeds;
+
+		// Tiled processing scratch, released once shapes are built
+		TArray<int32> TileStarts; // Offsets into TileNodes, with a trailing end offset
+		TArray<int32> TileNodes;  // Node indices grouped by tile, in node order within a tile
+		TArray<int32> TilePolygonStarts;
+		TArray<int32> TilePolygonKeys; // Untiled order key of each tiled polygon slot
+		TArray<int32> PolygonSlots;
+		TArray<int32> Frontier;
+		TArray<int32> NextFrontier;
+		int32 FrontierDepth = 0;
+		FCriticalSection FrontierLock;
+
+		TArray<FZGRoad> Roads;
+		TArray<FZGPolygon> Polygons;
+		TArray<FZGConnection> Connections;
+		TArray<int32> ConnectorStart; // CSR offsets of each node's range in Connections
 
 		TSharedPtr<PCGExData::TBuffer<double>> PolygonRadiusBuffer;
 		TSharedPtr<PCGExData::TBuffer<int32>> PolygonRoutingTypeBuffer;
@@ -368,8 +1008,16 @@ namespace PCGExClusterToZoneGraph
 		TSharedPtr<PCGExData::TBuffer<int32>> RoadPointTypeBuffer;
 		TSharedPtr<PCGExData::TBuffer<int32>> AdditionalIntersectionTagsBuffer;
 		TSharedPtr<PCGExData::TBuffer<FName>> EdgeLaneProfileBuffer;
+		TArray<int32> EdgeLaneProfiles; // Vote bucket per edge, interned profile index or an unregistered name's bucket
+		int32 NumLaneProfileBuckets = 0;
 
 		TSharedPtr<PCGExDetails::TSettingValue<double>> TangentLengthGetter;
+		FRoadPrecomputeParams RoadParams;
+
+		TArray<TSharedPtr<PCGExData::FPointIO>> PathSlots; // Path output of each shape, polygons first, null when not output
+
+		/** Specialized road precompute, [0] for open chains and [1] for closed loops. */
+		FZGRoad::FPrecomputeKernel RoadKernels[2] = {nullptr, nullptr};
 
 	public:
 		FProcessor(const TSharedRef<PCGExData::FFacade>& InVtxDataFacade, const TSharedRef<PCGExData::FFacade>& InEdgeDataFacade)
@@ -381,7 +1029,59 @@ namespace PCGExClusterToZoneGraph
 
 		virtual bool Process(const TSharedPtr<PCGExMT::FTaskManager>& InTaskManager) override;
 		bool BuildChains();
+		uint64 ComputeChainKey() const;
+		void StoreChains();
 		virtual void CompleteWork() override;
+		void BuildConnectorTable();
+		void StartConnectorPhase();
+		void StartOrientation();
+		void StartDepthAssignment();
+		void StartFrontierLevel();
+		void StartChainOrientation();
+		void BuildShapes();
+		void BuildTiles();
+		void StartTiledPolygonPhase();
+		void StartTiledPolygonAssignment();
+		void AssignTilePolygons(const int32 Tile);
+		void OrderTiledPolygons();
+		void StartTiledRoadPhase();
+		void AssembleTiledRoad(const int32 ChainIndex);
+		void FinalizeShapes();
+		bool IsRoamingLoop(const int32 ChainIndex) const;
+		bool NeedsPolygon(const int32 NodeIndex) const;
+		void AssignShapeIds();
+		void MarkDirtyShapes();
+		bool ChainTouchesDirtyBounds(const PCGExClusters::FNodeChain& Chain) const;
+		void StartLaneProfilePhase();
+		void StartPolygonPrecomputePhase();
+		void StartRadiusSyncPhase();
+		int32 BuildRoadWindows(const int32 FirstRoadPoint);
+		int32 GetRoadAt(const int32 WindowIndex) const { return RoadOrder.IsEmpty() ? WindowIndex : RoadOrder[WindowIndex]; }
+		void StartRoadPrecomputePhase();
+		void OnRoadWindowReady();
+		void SetStagingSize(const int32 InNum);
+		void ReleaseStaging();
+		void UpdateStagingBytes();
+		void SelectRoadKernels();
+		uint64 ComputePrecomputeKey() const;
+		bool TryRestorePrecompute();
+		void StorePrecompute();
+		void OnPrecomputeComplete();
+		void BakeShapes();
+		void EmitStorage();
+		void StartCompileLoop();
+		bool PrepareCompile();
+		int32 GetRemainingShapes() const { return bWindowInFlight ? 0 : CompileEnd - CompileCursor; }
+		bool HasPendingWindows() const { return bWindowInFlight || CurrentWindow + 2 < WindowStarts.Num(); }
+		bool IsWaitingForWindow() const { return bWindowInFlight; }
+		void StartNextWindow();
+		bool IsNextShapePolygon() const { return CompileCursor < Polygons.Num(); }
+		int32 CompileShapes(const int32 Count);
+		/** Updates and attaches a compiled shape, or holds both until generation completes. */
+		void CommitShape(const FZGBase& Shape, const bool bAttach);
+		void OnCompileComplete();
+		void StartPathOutputPhase();
+		void BuildPathOutput(const int32 Index);
 		virtual void ProcessRange(const PCGExMT::FScope& Scope) override;
 		virtual void OnRangeProcessingComplete() override;
 
@@ -389,8 +1089,50 @@ namespace PCGExClusterToZoneGraph
 
 		virtual void Cleanup() override;
 
-		void ComputeDFSOrientation(TArray<bool>& OutReversed) const;
-		FZoneLaneProfileRef ResolveLaneProfileByName(FName ProfileName) const;
+		void BuildOrientationGraph();
+		void AssignComponentDepths(const int32 Seed, TArray<int32>& Queue);
+		bool OrientChain(const int32 ChainIndex) const;
+		int32 ResolveLaneProfileIndex(FName ProfileName) const;
+		void AssignUnknownLaneProfileBuckets();
+		const FLaneProfileEntry& GetLaneProfile(const int32 Index) const { return Context->LaneProfiles[Index]; }
+	};
+
+	/** Gathers component compilation from every processor of a context into a single queue,
+	 * drained on the game thread in budgeted slices of one tick each. */
+	class FCompileScheduler : public TSharedFromThis<FCompileScheduler>
+	{
+	protected:
+		FPCGExClusterToZoneGraphContext* Context = nullptr;
+		bool bLogStats = false;
+
+		mutable FCriticalSection QueueLock;
+		TArray<TSharedPtr<FProcessor>> Queue;
+		bool bRunning = false;
+
+		TSharedPtr<PCGExMT::FTimeSlicedMainThreadLoop> CurrentSlice;
+		TSharedPtr<PCGExMT::FTimeSlicedMainThreadLoop> PreviousSlice;
+
+	public:
+		FCompileBudget Budget;
+		int32 NumCompiled = 0;
+		int32 NumProcessors = 0;
+		int32 PeakQueueDepth = 0;
+
+		FCompileScheduler(FPCGExClusterToZoneGraphContext* InContext, const double InBudgetSeconds, const bool bInLogStats);
+
+		void Enqueue(const TSharedPtr<FProcessor>& InProcessor, const TSharedPtr<PCGExMT::FTaskManager>& InTaskManager);
+		int32 GetQueueDepth() const;
+
+		/** Restarts the slice chain if it stopped, e.g. while every queued processor was waiting on a window. */
+		void Wake(const TSharedPtr<PCGExMT::FTaskManager>& InTaskManager);
+
+		/** Runs Step until it reports nothing is left or this frame's budget is spent. Returns true once nothing is left. Game thread only. */
+		bool RunBudgeted(const TFunctionRef<bool()>& Step);
+
+	protected:
+		void StartSlice(const TSharedPtr<PCGExMT::FTaskManager>& InTaskManager);
+		void RunSlice();
+		void LogStats() const;
 	};
 
 	class FBatch final : public PCGExClusterMT::TBatch<FProcessor>
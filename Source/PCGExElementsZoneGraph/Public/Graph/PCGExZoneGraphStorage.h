@@ -0,0 +1,73 @@
+﻿// Copyright 2025 Timothé Lapetite and contributors
+// Released under the MIT license https://opensource.org/license/MIT/
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ZoneGraphTypes.h"
+#include "ZoneShapeUtilities.h"
+
+class AActor;
+class AZoneGraphData;
+
+/** Zone shapes tessellated straight into ZoneGraph storage, without going through shape components. */
+namespace PCGExZoneGraphStorage
+{
+	/** Where a zone's lanes can meet another zone's: spline ends and lane profile points of polygons, as shape components expose them. */
+	struct FConnector
+	{
+		FVector Position = FVector::ZeroVector;
+		FGuid Profile;
+		double HalfWidth = 0; // Half the profile width, lanes ending further away belong to another connector
+	};
+
+	/** Lanes of one cluster. Zone, lane and point indices are local to the chunk until merged. */
+	struct FChunk
+	{
+		uint64 SortKey = 0;
+		FMatrix LocalToWorld = FMatrix::Identity;
+		FZoneGraphStorage Storage;
+		TArray<FZoneShapeLaneInternalLink> Links;
+
+		TArray<FConnector> Connectors;
+		TArray<int32> ConnectorStarts; // Offsets into Connectors per zone, with a trailing end offset
+
+		/** Tessellates a spline shape, returns its zone index or -1 if it produced none. */
+		int32 AddSpline(TConstArrayView<FZoneShapePoint> InPoints, const FZoneLaneProfile& InProfile, const FZoneGraphTagMask InTags);
+
+		/** Tessellates a polygon shape with one lane profile per point, returns its zone index or -1 if it produced none. */
+		int32 AddPolygon(TConstArrayView<FZoneShapePoint> InPoints, const EZoneShapePolygonRoutingType InRoutingType, TConstArrayView<FZoneLaneProfile> InProfiles, const FZoneGraphTagMask InTags);
+
+		/** Links lanes of two zones the way the ZoneGraph builder connects shapes: connectors within snap distance and sharing a lane profile
+		 * pair lanes at the same offset across the profile, heading the same way within the snap angle. */
+		void ConnectZones(const int32 ZoneA, const int32 ZoneB);
+
+	protected:
+		int32 FinishZone(const int32 InNumZones);
+		void AddConnector(const FZoneShapePoint& InPoint, const FZoneLaneProfile& InProfile);
+		void LinkLanes(const FConnector& From, const int32 FromZone, const FConnector& To, const int32 ToZone, const double SnapAngleCos);
+	};
+
+	/** Gathers cluster chunks from concurrent processors, and merges them in a deterministic order. */
+	class FWriter
+	{
+	protected:
+		FCriticalSection Lock;
+		TArray<FChunk> Chunks;
+		FZoneGraphStorage Merged;
+		bool bBuilt = false;
+
+	public:
+		void AddChunk(FChunk&& InChunk);
+
+		/** Merges every chunk into a single storage, with lane links, split and merge flags and spatial lookup resolved. Safe off the game thread. */
+		void Build();
+		bool IsBuilt() const { return bBuilt; }
+
+		/** Hands the merged storage to a new zone graph data actor in the target actor's level. Game thread only. */
+		AZoneGraphData* Emit(AActor* InTargetActor, const EObjectFlags InFlags);
+
+		/** Hands the merged storage to an existing zone graph data actor, replacing its own. Game thread only. */
+		void Apply(AZoneGraphData& InZoneGraphData);
+	};
+}
@@ -0,0 +1,224 @@
+﻿// Copyright 2025 Timothé Lapetite and contributors
+// Released under the MIT license https://opensource.org/license/MIT/
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ZoneGraphTypes.h"
+#include "Components/SceneComponent.h"
+
+#include "PCGExZoneShapeBake.generated.h"
+
+class AActor;
+class IMappedFileHandle;
+class IMappedFileRegion;
+class AZoneGraphData;
+
+struct FZoneGraphBuildData;
+
+namespace PCGExZoneGraphStorage
+{
+	struct FChunk;
+	class FWriter;
+}
+
+/** Baked zone shapes layout, native endianness, every section 8-byte aligned:
+ * [FHeader][FProfile x NumProfiles][FShape x NumShapes][FPoint x NumPoints] */
+namespace PCGExZoneShapeBake
+{
+	constexpr uint32 Magic = 0x475A5850; // "PXZG"
+	constexpr uint32 Version = 3;
+	constexpr uint16 NoLaneProfile = MAX_uint16;
+
+	struct FHeader
+	{
+		uint32 Magic = PCGExZoneShapeBake::Magic;
+		uint32 Version = PCGExZoneShapeBake::Version;
+		uint32 NumProfiles = 0;
+		uint32 NumShapes = 0;
+		uint32 NumPoints = 0;
+		uint32 Reserved = 0;
+	};
+
+	/** Lane profiles are stored by ID and resolved against the ZoneGraph settings on load. */
+	struct FProfile
+	{
+		FGuid ID;
+	};
+
+	enum class EShapeType : uint8
+	{
+		Spline  = 0,
+		Polygon = 1,
+	};
+
+	struct FShape
+	{
+		uint64 ShapeId = 0; // Stable shape identity, 0 when it collided
+		EShapeType Type = EShapeType::Spline;
+		uint8 RoutingType = 0;
+		uint16 Reserved = 0;
+		uint32 AdditionalTags = 0;
+		int32 LaneProfile = 0; // Common lane profile, index into the profile table
+		int32 FirstPoint = 0;
+		int32 NumPoints = 0;
+		int32 StartShape = -1; // Polygon shapes a spline connects to, -1 when open
+		int32 EndShape = -1;
+		uint32 Padding = 0; // Explicit, so no uninitialized bytes reach the blob
+	};
+
+	struct FPoint
+	{
+		FVector Position = FVector::ZeroVector;
+		FRotator Rotation = FRotator::ZeroRotator;
+		float TangentLength = 0;
+		uint16 LaneProfile = NoLaneProfile; // Per-point lane profile, index into the profile table
+		FZoneShapePointType Type = FZoneShapePointType::Sharp;
+		uint8 Reserved = 0;
+	};
+
+	static_assert(sizeof(FHeader) % 8 == 0 && sizeof(FProfile) % 8 == 0 && sizeof(FShape) % 8 == 0 && sizeof(FPoint) % 8 == 0, "Baked sections must stay 8-byte aligned.");
+
+	/** Shapes of a single cluster, in compile order. */
+	struct FChunk
+	{
+		uint64 SortKey = 0;
+		TArray<FShape> Shapes;
+		TArray<FPoint> Points;
+
+		/** Appends a shape and its points, returns the chunk index of its first point. */
+		int32 AddShape(const FShape& InShape, const TArray<FZoneShapePoint>& InPoints);
+	};
+
+	/** Gathers cluster chunks from concurrent processors, and writes them in a deterministic order. */
+	class FWriter
+	{
+	protected:
+		FCriticalSection Lock;
+		TArray<FProfile> Profiles;
+		TArray<FChunk> Chunks;
+
+	public:
+		explicit FWriter(const TArray<FZoneLaneProfileRef>& InProfiles);
+
+		void AddChunk(FChunk&& InChunk);
+
+		/** Serializes every chunk in the baked layout. */
+		void Write(TArray<uint8>& OutBlob);
+		bool Save(const FString& InPath);
+	};
+
+	/** Read-only view over baked shapes. Sections point straight into the source bytes, which must outlive the view. */
+	class FShapesView
+	{
+	public:
+		TConstArrayView<FProfile> Profiles;
+		TConstArrayView<FShape> Shapes;
+		TConstArrayView<FPoint> Points;
+
+		/** Validates the layout, every range and enum once, so consumers don't need to. */
+		bool Parse(const uint8* InData, const int64 InSize);
+
+		/** Tessellates every shape into zone storage and links splines to the polygons at their ends. */
+		void EmitTo(PCGExZoneGraphStorage::FChunk& OutChunk, const FZoneGraphTagMask InDefaultTags) const;
+	};
+
+	/** Baked shapes read from a memory-mapped file. */
+	class FMappedShapes : public FShapesView
+	{
+	protected:
+		TUniquePtr<IMappedFileHandle> Handle;
+		TUniquePtr<IMappedFileRegion> Region;
+
+	public:
+		FMappedShapes();
+		~FMappedShapes();
+
+		bool Open(const FString& InPath);
+	};
+
+	/** Lane profile from the ZoneGraph settings, if any matches the given ID. */
+	const FZoneLaneProfile* FindLaneProfile(const FGuid& InID);
+
+	/** Full path of a baked file, relative paths are resolved against the project directory. */
+	FString ResolvePath(const FString& InPath);
+
+	/** Default baked files directory, relative to the project directory. */
+	constexpr const TCHAR* DefaultDirectory = TEXT("Content/PCGEx/ZoneShapes");
+
+	/** Default baked file for a bake source, one per level and actor. InSourceName tells apart several sources on the same actor. */
+	FString MakeDefaultPath(const AActor* InActor, const FString& InSourceName);
+
+#if WITH_EDITOR
+	/** Adds the directory of a baked file to the packaging settings' loose (non-UFS) files, so cooked builds can still memory-map it.
+	 * Returns false when the file lives outside the Content directory and can't be staged. */
+	bool StageWithContent(const FString& InPath);
+#endif
+
+	/** Tessellates shapes relative to a component, as a single chunk of the given writer. */
+	void WriteLanes(const FShapesView& InShapes, const USceneComponent* InComponent, PCGExZoneGraphStorage::FWriter& OutWriter);
+}
+
+/** Feeds zone shapes held in the baked layout to ZoneGraph as individual zones, through a transient ZoneGraph Data actor on the owner.
+ * Lanes are emitted on BeginPlay in game worlds and by the generating node in the editor, never from registration,
+ * which also runs while loading, for construction scripts, undo and preview worlds. */
+UCLASS(Abstract, MinimalAPI)
+class UPCGExZoneLanesComponent : public USceneComponent
+{
+	GENERATED_BODY()
+
+public:
+	/** Emits lanes unless they already are. Game thread only. */
+	void EmitLanes();
+	void ReleaseLanes();
+
+	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+	virtual void OnComponentDestroyed(bool bDestroyingHierarchy) override;
+
+protected:
+	UPROPERTY(Transient)
+	TObjectPtr<AZoneGraphData> ZoneGraphData;
+
+	/** Tessellates the held shapes into the writer. False when there is nothing to emit. */
+	virtual bool WriteLanes(PCGExZoneGraphStorage::FWriter& OutWriter) const PURE_VIRTUAL(UPCGExZoneLanesComponent::WriteLanes, return false;);
+
+#if WITH_EDITOR
+	/** Editor builds rebuild every ZoneGraph Data of the level from shape components, so emitted lanes are written back after each one. */
+	FDelegateHandle BuildDoneHandle;
+	void OnZoneGraphBuildDone(const FZoneGraphBuildData& InBuildData);
+#endif
+};
+
+/** Feeds the zone shapes of a baked file to ZoneGraph without any shape component.
+ * Lanes are tessellated straight from the memory-mapped file, only the file reference is saved with the level. */
+UCLASS(MinimalAPI, BlueprintType, ClassGroup = (Procedural), meta=(BlueprintSpawnableComponent))
+class UPCGExBakedZoneShapesComponent : public UPCGExZoneLanesComponent
+{
+	GENERATED_BODY()
+
+public:
+	/** Baked zone shapes file, relative to the project directory. */
+	UPROPERTY(BlueprintReadOnly, EditAnywhere, Category = "ZoneGraph")
+	FString BakedFile;
+
+protected:
+	virtual bool WriteLanes(PCGExZoneGraphStorage::FWriter& OutWriter) const override;
+};
+
+/** Holds many zone shapes packed in the baked layout, saved with the level.
+ * A single component and a transient ZoneGraph Data actor stand in for one shape component per road and polygon. */
+UCLASS(MinimalAPI, BlueprintType, ClassGroup = (Procedural), meta=(BlueprintSpawnableComponent))
+class UPCGExZoneShapeContainerComponent : public UPCGExZoneLanesComponent
+{
+	GENERATED_BODY()
+
+public:
+	/** Packed shapes, serialized as a single versioned blob. */
+	TArray<uint8> PackedShapes;
+
+	virtual void Serialize(FArchive& Ar) override;
+
+protected:
+	virtual bool WriteLanes(PCGExZoneGraphStorage::FWriter& OutWriter) const override;
+};
@@ -6,6 +6,8 @@
 #include "CoreMinimal.h"
 #include "PCGExLegacyModuleInterface.h"
 
+DECLARE_LOG_CATEGORY_EXTERN(LogPCGExZoneGraph, Log, All);
+
 class FPCGExElementsZoneGraphModule final : public IPCGExLegacyModuleInterface
 {
 	PCGEX_MODULE_BODY